@@ -12,6 +12,9 @@
 
 //#define DSM_DEBUG
 //#define DSM_NVM_FACTORY_RESET
+//#define DSM_CLI_BULK_ACCESS
+//#define DSM_ERROR_LOG
+//#define DSM_SCHEDULER_STATISTICS
 
 /*** Board options ***/
 
@@ -34,6 +37,7 @@
 //#define BPSM_CHARGE_CONTROL_FORCED_HARDWARE
 #define BPSM_CHARGE_STATUS_FORCED_HARDWARE
 #define BPSM_BACKUP_CONTROL_FORCED_HARDWARE
+#define BPSM_STORAGE_CAPACITY_MAH                   8
 #ifdef DSM_NVM_FACTORY_RESET
 #define BPSM_CHARGE_SOURCE_VOLTAGE_TH_MV             6000
 #define BPSM_CHARGE_TOGGLE_PERIOD_SECONDS            300
@@ -77,9 +81,19 @@
 #endif
 #endif
 
+#ifdef UHFM
+#define UHFM_UPLINK_QUEUE_DEPTH                     8
+#endif
+
 #ifdef MPMCM
 // Measurements selection.
 #define MPMCM_ANALOG_MEASURE_ENABLE
+//#define MPMCM_ANALOG_SIMULATION
+//#define MPMCM_ANALOG_MEASURE_PROFILING
+//#define MPMCM_ANALOG_MEASURE_CMSIS_DSP
+//#define MPMCM_ANALOG_MEASURE_HARMONICS
+//#define MPMCM_DATA_SINGLE_PRECISION
+#define MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS      3600
 //#define MPMCM_LINKY_TIC_ENABLE
 // Linky TIC mode.
 #define MPMCM_LINKY_TIC_MODE_HISTORIC
@@ -119,6 +133,7 @@
 //#define BCM_CHARGE_STATUS_FORCED_HARDWARE
 #define BCM_CHARGE_LED_FORCED_HARDWARE
 #define BCM_BACKUP_CONTROL_FORCED_HARDWARE
+//#define BCM_STORAGE_CAPACITY_MAH                  7000
 #ifdef DSM_NVM_FACTORY_RESET
 #define BCM_CHARGE_SOURCE_VOLTAGE_TH_MV             16000
 #define BCM_CHARGE_TOGGLE_PERIOD_SECONDS            3600
@@ -34,6 +34,7 @@
 // Middleware.
 #include "analog.h"
 #include "digital.h"
+#include "error_log.h"
 #include "cli.h"
 #include "gps.h"
 #include "measure.h"
@@ -84,8 +85,11 @@ typedef enum {
     // Sigfox.
     ERROR_BASE_SIGFOX_EP_LIB = (ERROR_BASE_RFE + RFE_ERROR_BASE_LAST),
     ERROR_BASE_SIGFOX_EP_ADDON_RFP = (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_LAST * ERROR_BASE_STEP)),
+    // Bases added after the initial list (kept at the end to preserve the existing codes).
+    ERROR_BASE_TIM_RADIO_BUSY = (ERROR_BASE_SIGFOX_EP_ADDON_RFP + ERROR_BASE_STEP),
+    ERROR_BASE_ERROR_LOG = (ERROR_BASE_TIM_RADIO_BUSY + TIM_ERROR_BASE_LAST),
     // Last base value.
-    ERROR_BASE_LAST = (ERROR_BASE_SIGFOX_EP_ADDON_RFP + ERROR_BASE_STEP)
+    ERROR_BASE_LAST = (ERROR_BASE_ERROR_LOG + ERROR_LOG_ERROR_BASE_LAST)
 } ERROR_base_t;
 
 #endif /* __ERROR_BASE_H__ */
@@ -6,6 +6,7 @@
  */
 
 // Peripherals.
+#include "critical.h"
 #include "exti.h"
 #ifdef MPMCM
 #include "fpu.h"
@@ -24,8 +25,10 @@
 #include "error.h"
 // Middleware.
 #include "cli.h"
+#include "error_log.h"
 #include "node.h"
 #include "power.h"
+#include "scheduler.h"
 // Applicative.
 #include "dsm_flags.h"
 #include "dsm_flags_slave.h"
@@ -65,6 +68,9 @@ static void _DSM_init_hw(void) {
     LPTIM_status_t lptim_status = LPTIM_SUCCESS;
     NODE_status_t node_status = NODE_SUCCESS;
     CLI_status_t cli_status = CLI_SUCCESS;
+#ifdef DSM_ERROR_LOG
+    ERROR_LOG_status_t error_log_status = ERROR_LOG_SUCCESS;
+#endif
 #ifndef DSM_DEBUG
     IWDG_status_t iwdg_status = IWDG_SUCCESS;
 #endif
@@ -84,6 +90,7 @@ static void _DSM_init_hw(void) {
     GPIO_init();
     POWER_init();
     EXTI_init();
+    SCHEDULER_init();
 #ifndef DSM_DEBUG
     // Start independent watchdog.
     iwdg_status = IWDG_init();
@@ -110,6 +117,11 @@ static void _DSM_init_hw(void) {
     // Init delay timer.
     lptim_status = LPTIM_init(NVIC_PRIORITY_DELAY);
     LPTIM_stack_error(ERROR_BASE_LPTIM);
+#ifdef DSM_ERROR_LOG
+    // Init error log.
+    error_log_status = ERROR_LOG_init();
+    ERROR_LOG_stack_error(ERROR_BASE_ERROR_LOG);
+#endif
     // Init node layer.
     node_status = NODE_init();
     NODE_stack_error(ERROR_BASE_NODE);
@@ -124,23 +136,37 @@ int main(void) {
     // Local variables.
     NODE_status_t node_status = NODE_SUCCESS;
     CLI_status_t cli_status = CLI_SUCCESS;
+#ifdef DSM_ERROR_LOG
+    ERROR_LOG_status_t error_log_status = ERROR_LOG_SUCCESS;
+#endif
+    uint32_t ready_tasks = 0;
+#ifndef DSM_DEBUG
+    uint32_t primask = 0;
+#endif
     // Init board.
     _DSM_init_hw();
     // Main loop.
     while (1) {
         IWDG_reload();
 #ifndef DSM_DEBUG
-        // Enter sleep or stop mode depending on node state.
-        if (NODE_get_state() == NODE_STATE_IDLE) {
+        // Mask interrupts so that an event posted after the idle check still wakes up the core (WFI exits on pending interrupts even when masked).
+        CRITICAL_enter(primask);
+        // Enter low power mode only if no task is ready.
+        if (SCHEDULER_is_idle() != 0) {
+            // Enter sleep or stop mode depending on node state.
+            if (NODE_get_state() == NODE_STATE_IDLE) {
 #ifdef MPMCM
-            PWR_enter_deepsleep_mode(PWR_DEEPSLEEP_MODE_STOP_1);
+                PWR_enter_deepsleep_mode(PWR_DEEPSLEEP_MODE_STOP_1);
 #else
-            PWR_enter_deepsleep_mode(PWR_DEEPSLEEP_MODE_STOP);
+                PWR_enter_deepsleep_mode(PWR_DEEPSLEEP_MODE_STOP);
 #endif
+            }
+            else {
+                PWR_enter_sleep_mode(PWR_SLEEP_MODE_NORMAL);
+            }
         }
-        else {
-            PWR_enter_sleep_mode(PWR_SLEEP_MODE_NORMAL);
-        }
+        // Serve pending interrupts.
+        CRITICAL_exit(primask);
         IWDG_reload();
 #endif
 #ifdef MPMCM
@@ -153,11 +179,22 @@ int main(void) {
             NODE_stack_error(ERROR_BASE_NODE);
         }
 #endif
+        // Get tasks to run.
+        ready_tasks = SCHEDULER_get_ready_tasks();
         // Perform command task.
-        cli_status = CLI_process();
-        CLI_stack_error(ERROR_BASE_CLI);
+        if ((ready_tasks & (0b1 << SCHEDULER_TASK_CLI)) != 0) {
+            cli_status = CLI_process();
+            CLI_stack_error(ERROR_BASE_CLI);
+        }
         // Perform node tasks.
-        node_status = NODE_process();
-        NODE_stack_error(ERROR_BASE_NODE);
+        if ((ready_tasks & (0b1 << SCHEDULER_TASK_NODE)) != 0) {
+            node_status = NODE_process();
+            NODE_stack_error(ERROR_BASE_NODE);
+        }
+#ifdef DSM_ERROR_LOG
+        // Timestamp new errors.
+        error_log_status = ERROR_LOG_process();
+        ERROR_LOG_stack_error(ERROR_BASE_ERROR_LOG);
+#endif
     }
 }
@@ -25,6 +25,7 @@ typedef enum {
     LED_SUCCESS = 0,
     LED_ERROR_NULL_DURATION,
     LED_ERROR_COLOR,
+    LED_ERROR_NULL_PARAMETER,
     // Low level drivers errors.
     LED_ERROR_BASE_TIM_PWM = ERROR_BASE_STEP,
     LED_ERROR_BASE_TIM_DIMMING = (LED_ERROR_BASE_TIM_PWM + TIM_ERROR_BASE_LAST),
@@ -61,16 +62,22 @@ typedef enum {
     LED_STATE_LAST
 } LED_state_t;
 
+/*!******************************************************************
+ * \fn LED_process_cb_t
+ * \brief LED driver process callback.
+ *******************************************************************/
+typedef void (*LED_process_cb_t)(void);
+
 /*** LED functions ***/
 
 /*!******************************************************************
- * \fn LED_status_t LED_init(void)
+ * \fn LED_status_t LED_init(LED_process_cb_t process_callback)
  * \brief Init LED driver.
- * \param[in]   none
+ * \param[in]   process_callback: Function called from interrupt when the LED_process() function has to be called (unused on MPMCM).
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-LED_status_t LED_init(void);
+LED_status_t LED_init(LED_process_cb_t process_callback);
 
 /*!******************************************************************
  * \fn LED_status_t LED_de_init(void)
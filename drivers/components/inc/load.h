@@ -12,8 +12,13 @@
 #include "dsm_flags_slave.h"
 #include "error.h"
 #include "lptim.h"
+#include "tim.h"
 #include "types.h"
 
+/*** LOAD macros ***/
+
+#define LOAD_OUTPUT_STATE_UNKNOWN       0xFF
+
 /*** LOAD structures ***/
 
 /*!******************************************************************
@@ -24,24 +29,38 @@ typedef enum {
     // Driver errors.
     LOAD_SUCCESS = 0,
     LOAD_ERROR_STATE,
+    LOAD_ERROR_NULL_PARAMETER,
     // Low level drivers errors.
     LOAD_ERROR_BASE_LPTIM = ERROR_BASE_STEP,
+#if (defined LVRM) && (defined HW2_0)
+    // Relay sequence timer (kept at the end to preserve the existing codes of the other boards).
+    LOAD_ERROR_BASE_TIM = (LOAD_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST),
+    // Last base value.
+    LOAD_ERROR_BASE_LAST = (LOAD_ERROR_BASE_TIM + TIM_ERROR_BASE_LAST)
+#else
     // Last base value.
     LOAD_ERROR_BASE_LAST = (LOAD_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST)
+#endif
 } LOAD_status_t;
 
 #ifdef DSM_LOAD_CONTROL
 
+/*!******************************************************************
+ * \fn LOAD_process_cb_t
+ * \brief LOAD driver process callback.
+ *******************************************************************/
+typedef void (*LOAD_process_cb_t)(void);
+
 /*** LOAD functions ***/
 
 /*!******************************************************************
- * \fn void LOAD_init(void)
+ * \fn LOAD_status_t LOAD_init(LOAD_process_cb_t process_callback)
  * \brief Init load interface.
- * \param[in]   none
+ * \param[in]   process_callback: Function called from interrupt when the LOAD_process() function has to be called (only used by the LVRM HW2.0 relay sequence).
  * \param[out]  none
- * \retval      none
+ * \retval      Function execution status.
  *******************************************************************/
-void LOAD_init(void);
+LOAD_status_t LOAD_init(LOAD_process_cb_t process_callback);
 
 /*!******************************************************************
  * \fn LOAD_status_t LOAD_set_output_state(uint8_t state)
@@ -57,10 +76,32 @@ LOAD_status_t LOAD_set_output_state(uint8_t state);
  * \brief Read load output state.
  * \param[in]   none
  * \param[out]  none
- * \retval      Load state.
+ * \retval      Load state (last stable state while the relay sequence is running).
  *******************************************************************/
 uint8_t LOAD_get_output_state(void);
 
+#if (defined LVRM) && (defined HW2_0)
+/*!******************************************************************
+ * \fn LOAD_status_t LOAD_process(void)
+ * \brief Execute the next step of the relay sequence when its timer has elapsed.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+LOAD_status_t LOAD_process(void);
+#endif
+
+#if (defined LVRM) && (defined HW2_0)
+/*!******************************************************************
+ * \fn uint8_t LOAD_is_switching(void)
+ * \brief Check if the relay sequence is running.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      1 if the relay sequence is running, 0 otherwise.
+ *******************************************************************/
+uint8_t LOAD_is_switching(void);
+#endif
+
 #if ((defined BCM) || (defined BPSM))
 /*!******************************************************************
  * \fn void LOAD_set_charge_state(uint8_t state)
@@ -98,7 +139,7 @@ uint8_t LOAD_get_charge_status(void);
 #define LOAD_exit_error(error_base) { if (load_status != LOAD_SUCCESS) { status = (error_base + load_status); goto errors; } }
 
 /*******************************************************************/
-#define LOAD_stack_error(void) { if (load_status != LOAD_SUCCESS) { ERROR_stack_add(ERROR_BASE_LOAD + load_status); } }
+#define LOAD_stack_error(base) { if (load_status != LOAD_SUCCESS) { ERROR_stack_add(base + load_status); } }
 
 /*******************************************************************/
 #define LOAD_stack_exit_error(error_code) { if (load_status != LOAD_SUCCESS) { ERROR_stack_add(ERROR_BASE_LOAD + load_status); status = error_code; goto errors; } }
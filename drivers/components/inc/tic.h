@@ -58,16 +58,22 @@ typedef enum {
     TIC_STATE_LAST
 } TIC_state_t;
 
+/*!******************************************************************
+ * \fn TIC_process_cb_t
+ * \brief TIC driver process callback.
+ *******************************************************************/
+typedef void (*TIC_process_cb_t)(void);
+
 /*** TIC functions ***/
 
 /*!******************************************************************
- * \fn TIC_status_t TIC_init(void)
+ * \fn TIC_status_t TIC_init(TIC_process_cb_t process_callback)
  * \brief Init TIC driver.
- * \param[in]   none
+ * \param[in]   process_callback: Function called from interrupt when the TIC_process() function has to be called.
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-TIC_status_t TIC_init(void);
+TIC_status_t TIC_init(TIC_process_cb_t process_callback);
 
 /*!******************************************************************
  * \fn TIC_status_t TIC_de_init(void)
@@ -136,6 +142,33 @@ TIC_status_t TIC_get_detect_flag(uint8_t* linky_tic_connected);
  *******************************************************************/
 TIC_status_t TIC_get_channel_run_data(DATA_run_channel_t* channel_run_data);
 
+/*!******************************************************************
+ * \fn TIC_status_t TIC_get_energy_index(DATA_run_t* energy_index_wh)
+ * \brief Get the last energy index read on the meter.
+ * \param[in]   none
+ * \param[out]  energy_index_wh: Pointer to the energy index in Wh.
+ * \retval      Function execution status.
+ *******************************************************************/
+TIC_status_t TIC_get_energy_index(DATA_run_t* energy_index_wh);
+
+/*!******************************************************************
+ * \fn TIC_status_t TIC_get_checksum_error_count(uint32_t* checksum_error_count)
+ * \brief Get the number of groups rejected because of a checksum error.
+ * \param[in]   none
+ * \param[out]  checksum_error_count: Pointer to the number of checksum errors.
+ * \retval      Function execution status.
+ *******************************************************************/
+TIC_status_t TIC_get_checksum_error_count(uint32_t* checksum_error_count);
+
+/*!******************************************************************
+ * \fn TIC_status_t TIC_get_buffer_overrun_count(uint32_t* buffer_overrun_count)
+ * \brief Get the number of reception buffers overwritten before being processed.
+ * \param[in]   none
+ * \param[out]  buffer_overrun_count: Pointer to the number of buffer overruns.
+ * \retval      Function execution status.
+ *******************************************************************/
+TIC_status_t TIC_get_buffer_overrun_count(uint32_t* buffer_overrun_count);
+
 /*!******************************************************************
  * \fn TIC_status_t TIC_get_channel_accumulated_data(TIC_accumulated_data_t* channel_accumulated_data)
  * \brief Get accumulated data.
@@ -32,6 +32,7 @@
 /*******************************************************************/
 typedef struct {
     volatile uint8_t process_flag;
+    LED_process_cb_t process_callback;
     LED_color_t color;
     uint8_t dimming_lut_direction;
     uint32_t dimming_lut_index;
@@ -69,6 +70,7 @@ static const uint8_t LED_DIMMING_LUT[LED_DIMMING_LUT_SIZE] = {
 #ifndef MPMCM
 static LED_context_t led_ctx = {
     .process_flag = 0,
+    .process_callback = NULL,
     .color = LED_COLOR_OFF,
     .dimming_lut_direction = 0,
     .dimming_lut_index = 0,
@@ -111,19 +113,28 @@ errors:
 static void _LED_dimming_timer_irq_callback(void) {
     // Set process flag.
     led_ctx.process_flag = 1;
+    led_ctx.process_callback();
 }
 #endif
 
 /*** LED functions ***/
 
 /*******************************************************************/
-LED_status_t LED_init(void) {
+LED_status_t LED_init(LED_process_cb_t process_callback) {
     // Local variables.
     LED_status_t status = LED_SUCCESS;
     TIM_status_t tim_status = TIM_SUCCESS;
-#ifndef MPMCM
+#ifdef MPMCM
+    UNUSED(process_callback);
+#else
+    // Check parameter.
+    if (process_callback == NULL) {
+        status = LED_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
     // Init context.
     led_ctx.process_flag = 0;
+    led_ctx.process_callback = process_callback;
     led_ctx.color = LED_COLOR_OFF;
     led_ctx.dimming_lut_direction = 0;
     led_ctx.dimming_lut_index = 0;
@@ -11,32 +11,141 @@
 #include "dsm_flags_slave.h"
 #include "error.h"
 #include "gpio.h"
-#include "lptim.h"
 #include "mcu_mapping.h"
+#include "nvic_priority.h"
+#include "tim.h"
 #include "types.h"
 
 #ifdef DSM_LOAD_CONTROL
 
 /*** LOAD local macros ***/
 
+#if (defined LVRM) && (defined HW2_0)
 #define LOAD_DC_DC_DELAY_MS             100
 #define LOAD_VCOIL_DELAY_MS             100
 #define LOAD_RELAY_CONTROL_DURATION_MS  1000
+#endif
+
+/*** LOAD local structures ***/
+
+#if (defined LVRM) && (defined HW2_0)
+/*******************************************************************/
+typedef enum {
+    LOAD_RELAY_STEP_IDLE = 0,
+    LOAD_RELAY_STEP_DC_DC,
+    LOAD_RELAY_STEP_COIL,
+    LOAD_RELAY_STEP_CONTROL,
+    LOAD_RELAY_STEP_LAST
+} LOAD_relay_step_t;
+#endif
+
+/*******************************************************************/
+typedef struct {
+    uint8_t state;
+#if (defined LVRM) && (defined HW2_0)
+    volatile uint8_t process_flag;
+    LOAD_process_cb_t process_callback;
+    LOAD_relay_step_t relay_step;
+    uint8_t requested_state;
+    uint8_t relay_control_state;
+#endif
+} LOAD_context_t;
 
 /*** LOAD local global variables ***/
 
-static uint8_t load_state = 0xFF;
+static LOAD_context_t load_ctx = {
+    .state = LOAD_OUTPUT_STATE_UNKNOWN,
+#if (defined LVRM) && (defined HW2_0)
+    .process_flag = 0,
+    .process_callback = NULL,
+    .relay_step = LOAD_RELAY_STEP_IDLE,
+    .requested_state = LOAD_OUTPUT_STATE_UNKNOWN,
+    .relay_control_state = LOAD_OUTPUT_STATE_UNKNOWN,
+#endif
+};
+
+/*** LOAD local functions ***/
+
+#if (defined LVRM) && (defined HW2_0)
+/*******************************************************************/
+static void _LOAD_relay_timer_irq_callback(void) {
+    // Set process flag.
+    load_ctx.process_flag = 1;
+    load_ctx.process_callback();
+}
+#endif
+
+#if (defined LVRM) && (defined HW2_0)
+/*******************************************************************/
+static LOAD_status_t _LOAD_start_relay_step(LOAD_relay_step_t relay_step, uint32_t duration_ms) {
+    // Local variables.
+    LOAD_status_t status = LOAD_SUCCESS;
+    TIM_status_t tim_status = TIM_SUCCESS;
+    // Update step.
+    load_ctx.process_flag = 0;
+    load_ctx.relay_step = relay_step;
+    // Start step timer.
+    tim_status = TIM_STD_start(TIM_INSTANCE_RELAY, duration_ms, TIM_UNIT_MS, &_LOAD_relay_timer_irq_callback);
+    TIM_exit_error(LOAD_ERROR_BASE_TIM);
+errors:
+    return status;
+}
+#endif
+
+#if (defined LVRM) && (defined HW2_0)
+/*******************************************************************/
+static void _LOAD_stop_relay_sequence(void) {
+    // Stop step timer.
+    TIM_STD_stop(TIM_INSTANCE_RELAY);
+    // Relay position is not guaranteed if the control pulse has been interrupted.
+    if (load_ctx.relay_step == LOAD_RELAY_STEP_CONTROL) {
+        load_ctx.state = LOAD_OUTPUT_STATE_UNKNOWN;
+    }
+    // Turn all GPIOs off.
+    GPIO_write(&GPIO_OUT_CONTROL, 0);
+    GPIO_write(&GPIO_OUT_SELECT, 0);
+    GPIO_write(&GPIO_COIL_POWER_ENABLE, 0);
+    GPIO_write(&GPIO_DC_DC_POWER_ENABLE, 0);
+    // Reset sequence.
+    load_ctx.process_flag = 0;
+    load_ctx.relay_step = LOAD_RELAY_STEP_IDLE;
+}
+#endif
 
 /*** LOAD functions ***/
 
 /*******************************************************************/
-void LOAD_init(void) {
+LOAD_status_t LOAD_init(LOAD_process_cb_t process_callback) {
+    // Local variables.
+    LOAD_status_t status = LOAD_SUCCESS;
+#if (defined LVRM) && (defined HW2_0)
+    TIM_status_t tim_status = TIM_SUCCESS;
+    // Check parameter.
+    if (process_callback == NULL) {
+        status = LOAD_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#else
+    UNUSED(process_callback);
+#endif
+    // Init context.
+    load_ctx.state = LOAD_OUTPUT_STATE_UNKNOWN;
+#if (defined LVRM) && (defined HW2_0)
+    load_ctx.process_flag = 0;
+    load_ctx.process_callback = process_callback;
+    load_ctx.relay_step = LOAD_RELAY_STEP_IDLE;
+    load_ctx.requested_state = LOAD_OUTPUT_STATE_UNKNOWN;
+    load_ctx.relay_control_state = LOAD_OUTPUT_STATE_UNKNOWN;
+#endif
     // Output control.
 #if (defined LVRM) && (defined HW2_0)
     GPIO_configure(&GPIO_DC_DC_POWER_ENABLE, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
     GPIO_configure(&GPIO_COIL_POWER_ENABLE, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
     GPIO_configure(&GPIO_OUT_SELECT, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
     GPIO_configure(&GPIO_OUT_CONTROL, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
+    // Init relay sequence timer.
+    tim_status = TIM_STD_init(TIM_INSTANCE_RELAY, NVIC_PRIORITY_RELAY);
+    TIM_exit_error(LOAD_ERROR_BASE_TIM);
 #else
     GPIO_configure(&GPIO_OUT_EN, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
 #endif
@@ -52,54 +161,111 @@ void LOAD_init(void) {
     GPIO_configure(&GPIO_CHRG_ST1, GPIO_MODE_INPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
 #endif
     // Open load by default.
-    LOAD_set_output_state(0);
+    status = LOAD_set_output_state(0);
+    if (status != LOAD_SUCCESS) goto errors;
+errors:
+    return status;
 }
 
 /*******************************************************************/
 LOAD_status_t LOAD_set_output_state(uint8_t state) {
     // Local variables.
     LOAD_status_t status = LOAD_SUCCESS;
-    // Directly exit with success if state is already set.
-    if (state == load_state) goto errors;
 #if (defined LVRM) && (defined HW2_0)
-    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    // Store request, the running sequence applies the latest one when it reaches the control step.
+    load_ctx.requested_state = state;
+    // Directly exit if a sequence is already running or if state is already set.
+    if ((load_ctx.relay_step != LOAD_RELAY_STEP_IDLE) || (state == load_ctx.state)) goto errors;
     // Enable DC-DC.
     GPIO_write(&GPIO_DC_DC_POWER_ENABLE, 1);
-    lptim_status = LPTIM_delay_milliseconds(LOAD_DC_DC_DELAY_MS, LPTIM_DELAY_MODE_STOP);
-    LPTIM_exit_error(LOAD_ERROR_BASE_LPTIM);
-    // Enable COIL voltage.
-    GPIO_write(&GPIO_COIL_POWER_ENABLE, 1);
-    lptim_status = LPTIM_delay_milliseconds(LOAD_VCOIL_DELAY_MS, LPTIM_DELAY_MODE_STOP);
-    LPTIM_exit_error(LOAD_ERROR_BASE_LPTIM);
-    // Select coil.
-    GPIO_write(&GPIO_OUT_SELECT, state);
-    // Set relay state.
-    GPIO_write(&GPIO_OUT_CONTROL, 1);
-    lptim_status = LPTIM_delay_milliseconds(LOAD_RELAY_CONTROL_DURATION_MS, LPTIM_DELAY_MODE_STOP);
-    LPTIM_exit_error(LOAD_ERROR_BASE_LPTIM);
+    status = _LOAD_start_relay_step(LOAD_RELAY_STEP_DC_DC, LOAD_DC_DC_DELAY_MS);
+    if (status != LOAD_SUCCESS) goto errors;
 #else
+    // Directly exit with success if state is already set.
+    if (state == load_ctx.state) goto errors;
     // Set GPIO.
     GPIO_write(&GPIO_OUT_EN, state);
-#endif
     // Update state.
-    load_state = state;
+    load_ctx.state = state;
+#endif
 errors:
 #if (defined LVRM) && (defined HW2_0)
-    // Turn all GPIOs off.
-    GPIO_write(&GPIO_OUT_CONTROL, 0);
-    GPIO_write(&GPIO_OUT_SELECT, 0);
-    GPIO_write(&GPIO_COIL_POWER_ENABLE, 0);
-    GPIO_write(&GPIO_DC_DC_POWER_ENABLE, 0);
+    if (status != LOAD_SUCCESS) {
+        _LOAD_stop_relay_sequence();
+    }
 #endif
     return status;
 }
 
 /*******************************************************************/
 uint8_t LOAD_get_output_state(void) {
-    // Read current state.
-    return load_state;
+    return load_ctx.state;
 }
 
+#if (defined LVRM) && (defined HW2_0)
+/*******************************************************************/
+uint8_t LOAD_is_switching(void) {
+    return ((load_ctx.relay_step == LOAD_RELAY_STEP_IDLE) ? 0 : 1);
+}
+#endif
+
+#if (defined LVRM) && (defined HW2_0)
+/*******************************************************************/
+LOAD_status_t LOAD_process(void) {
+    // Local variables.
+    LOAD_status_t status = LOAD_SUCCESS;
+    TIM_status_t tim_status = TIM_SUCCESS;
+    // Check process flag.
+    if ((load_ctx.process_flag == 0) || (load_ctx.relay_step == LOAD_RELAY_STEP_IDLE)) goto errors;
+    // Stop step timer.
+    tim_status = TIM_STD_stop(TIM_INSTANCE_RELAY);
+    TIM_exit_error(LOAD_ERROR_BASE_TIM);
+    // Check step.
+    switch (load_ctx.relay_step) {
+    case LOAD_RELAY_STEP_DC_DC:
+        // Enable COIL voltage.
+        GPIO_write(&GPIO_COIL_POWER_ENABLE, 1);
+        status = _LOAD_start_relay_step(LOAD_RELAY_STEP_COIL, LOAD_VCOIL_DELAY_MS);
+        if (status != LOAD_SUCCESS) goto errors;
+        break;
+    case LOAD_RELAY_STEP_COIL:
+        // Skip control pulse if the request has been cancelled in the meantime.
+        if (load_ctx.requested_state == load_ctx.state) {
+            _LOAD_stop_relay_sequence();
+            break;
+        }
+        // Latch the latest request.
+        load_ctx.relay_control_state = load_ctx.requested_state;
+        // Select coil.
+        GPIO_write(&GPIO_OUT_SELECT, load_ctx.relay_control_state);
+        // Set relay state.
+        GPIO_write(&GPIO_OUT_CONTROL, 1);
+        status = _LOAD_start_relay_step(LOAD_RELAY_STEP_CONTROL, LOAD_RELAY_CONTROL_DURATION_MS);
+        if (status != LOAD_SUCCESS) goto errors;
+        break;
+    case LOAD_RELAY_STEP_CONTROL:
+        // Update state.
+        load_ctx.relay_step = LOAD_RELAY_STEP_IDLE;
+        load_ctx.state = load_ctx.relay_control_state;
+        _LOAD_stop_relay_sequence();
+        // Apply the request received during the control pulse.
+        if (load_ctx.requested_state != load_ctx.state) {
+            status = LOAD_set_output_state(load_ctx.requested_state);
+            if (status != LOAD_SUCCESS) goto errors;
+        }
+        break;
+    default:
+        break;
+    }
+errors:
+    load_ctx.process_flag = 0;
+    if (status != LOAD_SUCCESS) {
+        _LOAD_stop_relay_sequence();
+    }
+    return status;
+}
+#endif
+
 #if ((defined BCM) || (defined BPSM))
 /*******************************************************************/
 void LOAD_set_charge_state(uint8_t state) {
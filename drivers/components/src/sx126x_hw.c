@@ -13,18 +13,53 @@
 
 #ifndef SX126X_DRIVER_DISABLE
 
+#include "critical.h"
 #include "error.h"
 #include "error_base.h"
+#include "exti.h"
 #include "gpio.h"
 #include "lptim.h"
 #include "mcu_mapping.h"
+#include "nvic_priority.h"
+#include "pwr.h"
 #include "spi.h"
 #include "sx126x.h"
+#include "tim.h"
 #include "types.h"
 
 /*** SX126X HW local macros ***/
 
-#define SX126X_HW_BUSY_TIMEOUT_COUNT    5000000
+#define SX126X_HW_BUSY_POLLING_COUNT    100
+#define SX126X_HW_BUSY_TIMEOUT_MS       100
+
+/*** SX126X HW local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    volatile uint8_t busy_falling_edge_flag;
+    volatile uint8_t busy_timeout_flag;
+} SX126X_HW_context_t;
+
+/*** SX126X HW local global variables ***/
+
+static SX126X_HW_context_t sx126x_hw_ctx = {
+    .busy_falling_edge_flag = 0,
+    .busy_timeout_flag = 0
+};
+
+/*** SX126X HW local functions ***/
+
+/*******************************************************************/
+static void _SX126X_HW_busy_irq_callback(void) {
+    // Set local flag.
+    sx126x_hw_ctx.busy_falling_edge_flag = 1;
+}
+
+/*******************************************************************/
+static void _SX126X_HW_busy_timer_irq_callback(void) {
+    // Set local flag.
+    sx126x_hw_ctx.busy_timeout_flag = 1;
+}
 
 /*** SX126X HW functions ***/
 
@@ -33,6 +68,7 @@ SX126X_status_t SX126X_HW_init(void) {
     // Local variables.
     SX126X_status_t status = SX126X_SUCCESS;
     SPI_status_t spi_status = SPI_SUCCESS;
+    TIM_status_t tim_status = TIM_SUCCESS;
     SPI_configuration_t spi_config;
     // Configure reset pin.
     GPIO_configure(&GPIO_SX1261_NRESET, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
@@ -48,6 +84,9 @@ SX126X_status_t SX126X_HW_init(void) {
     // Configure chip select pin.
     GPIO_configure(&GPIO_SX1261_CS, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
     GPIO_write(&GPIO_SX1261_CS, 1);
+    // Init busy timeout timer.
+    tim_status = TIM_STD_init(TIM_INSTANCE_RADIO_BUSY, NVIC_PRIORITY_RADIO_BUSY_TIMER);
+    TIM_stack_error(ERROR_BASE_TIM_RADIO_BUSY);
     errors:
     return status;
 }
@@ -57,6 +96,10 @@ SX126X_status_t SX126X_HW_de_init(void) {
     // Local variables.
     SX126X_status_t status = SX126X_SUCCESS;
     SPI_status_t spi_status = SPI_SUCCESS;
+    TIM_status_t tim_status = TIM_SUCCESS;
+    // Release busy timeout timer.
+    tim_status = TIM_STD_de_init(TIM_INSTANCE_RADIO_BUSY);
+    TIM_stack_error(ERROR_BASE_TIM_RADIO_BUSY);
     // Keep reset pin as output low.
     GPIO_write(&GPIO_SX1261_NRESET, 0);
     // Add pull-down resistor to busy pin.
@@ -82,16 +125,45 @@ SX126X_status_t SX126X_HW_set_nreset_gpio(uint8_t state) {
 SX126X_status_t SX126X_HW_wait_busy_low(void) {
     // Local variables.
     SX126X_status_t status = SX126X_SUCCESS;
+    TIM_status_t tim_status = TIM_SUCCESS;
     uint32_t loop_count = 0;
-    // Wait for busy pin to be low.
-    while (GPIO_read(&GPIO_SX1261_BUSY) != 0) {
-        // Exit of timeout.
-        loop_count++;
-        if (loop_count > SX126X_HW_BUSY_TIMEOUT_COUNT) {
+    uint32_t primask = 0;
+    uint8_t busy = 1;
+    // Short polling since most commands release the busy pin within a few microseconds.
+    for (loop_count = 0; loop_count < SX126X_HW_BUSY_POLLING_COUNT; loop_count++) {
+        if (GPIO_read(&GPIO_SX1261_BUSY) == 0) goto errors;
+    }
+    // Enable busy pin falling edge interrupt.
+    sx126x_hw_ctx.busy_falling_edge_flag = 0;
+    sx126x_hw_ctx.busy_timeout_flag = 0;
+    EXTI_configure_gpio(&GPIO_SX1261_BUSY, GPIO_PULL_NONE, EXTI_TRIGGER_FALLING_EDGE, &_SX126X_HW_busy_irq_callback, NVIC_PRIORITY_RADIO_BUSY);
+    EXTI_clear_gpio_flag(&GPIO_SX1261_BUSY);
+    EXTI_enable_gpio_interrupt(&GPIO_SX1261_BUSY);
+    // Start timeout timer.
+    tim_status = TIM_STD_start(TIM_INSTANCE_RADIO_BUSY, SX126X_HW_BUSY_TIMEOUT_MS, TIM_UNIT_MS, &_SX126X_HW_busy_timer_irq_callback);
+    if (tim_status != TIM_SUCCESS) {
+        TIM_stack_error(ERROR_BASE_TIM_RADIO_BUSY);
+        status = SX126X_ERROR_BUSY_TIMEOUT;
+    }
+    // Sleep until busy pin is low or timeout.
+    while (status == SX126X_SUCCESS) {
+        // Interrupts are masked so that an edge occurring between the check and the sleep entry still wakes up the core.
+        CRITICAL_enter(primask);
+        busy = ((sx126x_hw_ctx.busy_falling_edge_flag == 0) && (GPIO_read(&GPIO_SX1261_BUSY) != 0)) ? 1 : 0;
+        if ((busy != 0) && (sx126x_hw_ctx.busy_timeout_flag == 0)) {
+            PWR_enter_sleep_mode(PWR_SLEEP_MODE_NORMAL);
+        }
+        CRITICAL_exit(primask);
+        // Check exit conditions.
+        if (busy == 0) break;
+        if (sx126x_hw_ctx.busy_timeout_flag != 0) {
             status = SX126X_ERROR_BUSY_TIMEOUT;
-            goto errors;
         }
     }
+    // Release timer and busy pin.
+    TIM_STD_stop(TIM_INSTANCE_RADIO_BUSY);
+    EXTI_disable_gpio_interrupt(&GPIO_SX1261_BUSY);
+    EXTI_release_gpio(&GPIO_SX1261_BUSY, GPIO_MODE_INPUT);
 errors:
     return status;
 }
@@ -9,6 +9,7 @@
 
 #ifdef MPMCM
 
+#include "critical.h"
 #include "error.h"
 #include "error_base.h"
 #include "data.h"
@@ -19,7 +20,6 @@
 #include "maths.h"
 #include "mcu_mapping.h"
 #include "nvic_priority.h"
-#include "parser.h"
 #include "power.h"
 #include "strings.h"
 #include "types.h"
@@ -38,11 +38,25 @@
 
 #define TIC_LED_PULSE_DURATION_US           50000
 
+#define TIC_GROUP_BUFFER_SIZE               128
+#define TIC_GROUP_SIZE_MIN                  3
+
+#define TIC_FRAME_START_CHAR                0x02
+#define TIC_FRAME_END_CHAR                  0x03
+#define TIC_GROUP_START_CHAR                STRING_CHAR_LF
+#define TIC_GROUP_END_CHAR                  STRING_CHAR_CR
+
+#define TIC_CHECKSUM_MASK                   0x3F
+#define TIC_CHECKSUM_OFFSET                 0x20
+
+#define TIC_NUMBER_OF_FRAMES_MAX            2
+
 #ifdef MPMCM_LINKY_TIC_MODE_HISTORIC
 #define TIC_BAUD_RATE                       1200
-#define TIC_NUMBER_OF_DATA                  11
-#define TIC_FRAME_SEPARATOR_CHAR            STRING_CHAR_SPACE
-#define TIC_FRAME_END_CHAR                  STRING_CHAR_LF
+#define TIC_GROUP_SEPARATOR_CHAR            STRING_CHAR_SPACE
+#else
+#define TIC_BAUD_RATE                       9600
+#define TIC_GROUP_SEPARATOR_CHAR            0x09
 #endif
 
 /*** TIC local structures ***/
@@ -50,51 +64,70 @@
 /*******************************************************************/
 typedef enum {
     TIC_SAMPLE_INDEX_APPARENT_POWER_VA = 0,
+    TIC_SAMPLE_INDEX_RMS_VOLTAGE_V,
+    TIC_SAMPLE_INDEX_RMS_CURRENT_A,
+    TIC_SAMPLE_INDEX_ENERGY_INDEX_WH,
     TIC_SAMPLE_INDEX_LAST
 } TIC_sample_index_t;
 
 /*******************************************************************/
 typedef struct {
-    char_t* name;
-    STRING_format_t format;
+    char_t* label;
 } TIC_sample_t;
 
 /*******************************************************************/
 typedef union {
     uint8_t all;
     struct {
-        unsigned decode_success :1;
-        unsigned frame_received :1;
+        unsigned buffer_received :1;
         unsigned irq_received :1;
         unsigned fill_buffer0 :1;
+        unsigned buffer_overrun :1;
     } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } TIC_flags_t;
 
+/*******************************************************************/
+typedef union {
+    uint8_t all;
+    struct {
+        unsigned decode_success :1;
+        unsigned group_started :1;
+        unsigned group_overflow :1;
+        unsigned group_decoded :1;
+    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+} TIC_parser_flags_t;
+
 /*******************************************************************/
 typedef struct {
     DATA_run_channel_t run;
     DATA_accumulated_channel_t accumulated;
     DATA_run_t active_energy_mws_sum;
     DATA_run_t apparent_energy_mvas_sum;
+    DATA_run_t energy_index_wh;
 } TIC_data_t;
 
 /*******************************************************************/
 typedef struct {
     // State machine.
     TIC_state_t state;
+    TIC_process_cb_t process_callback;
     uint32_t sampling_period_seconds;
     uint32_t second_count_period;
     uint32_t second_count_sampling;
     volatile uint32_t second_count_inactivity;
     volatile TIC_flags_t flags;
+    TIC_parser_flags_t parser_flags;
     // DMA Buffers.
     volatile char_t dma_buffer0[TIC_RX_BUFFER_SIZE];
     volatile char_t dma_buffer1[TIC_RX_BUFFER_SIZE];
-    // Parsing buffer.
-    char_t frame[TIC_RX_BUFFER_SIZE];
-    uint8_t frame_size;
-    PARSER_context_t parser;
-    uint8_t decoding_count;
+    volatile uint8_t dma_buffer_size;
+    // Current group.
+    char_t group[TIC_GROUP_BUFFER_SIZE];
+    uint8_t group_size;
+    uint32_t group_sum;
+    uint8_t frame_count;
+    uint32_t checksum_error_count;
+    volatile uint32_t buffer_overrun_count;
 } TIC_context_t;
 
 /*** TIC local global variables ***/
@@ -102,7 +135,17 @@ typedef struct {
 #ifdef MPMCM_LINKY_TIC_ENABLE
 #ifdef MPMCM_LINKY_TIC_MODE_HISTORIC
 static const TIC_sample_t TIC_SAMPLE[TIC_SAMPLE_INDEX_LAST] = {
-    { "PAPP ", STRING_FORMAT_DECIMAL }
+    { "PAPP" },
+    { NULL },
+    { "IINST" },
+    { "BASE" }
+};
+#else
+static const TIC_sample_t TIC_SAMPLE[TIC_SAMPLE_INDEX_LAST] = {
+    { "SINSTS" },
+    { "URMS1" },
+    { "IRMS1" },
+    { "EAST" }
 };
 #endif
 #endif
@@ -113,9 +156,13 @@ static TIC_context_t tic_ctx;
 
 #ifdef MPMCM_LINKY_TIC_ENABLE
 /*******************************************************************/
-static void _TIC_switch_dma_buffer(uint8_t line_end_flag) {
+static void _TIC_switch_dma_buffer(void) {
+    // Local variables.
+    uint16_t number_of_bytes = 0;
     // Stop and start DMA transfer to switch buffer.
+    DMA_get_number_of_transfered_data(DMA_INSTANCE_TIC, DMA_CHANNEL_TIC, &number_of_bytes);
     DMA_stop(DMA_INSTANCE_TIC, DMA_CHANNEL_TIC);
+    tic_ctx.dma_buffer_size = (uint8_t) ((number_of_bytes > TIC_RX_BUFFER_SIZE) ? TIC_RX_BUFFER_SIZE : number_of_bytes);
     // Switch buffer.
     if (tic_ctx.flags.fill_buffer0 == 0) {
         DMA_set_memory_address(DMA_INSTANCE_TIC, DMA_CHANNEL_TIC, (uint32_t) &(tic_ctx.dma_buffer0), TIC_RX_BUFFER_SIZE);
@@ -125,9 +172,14 @@ static void _TIC_switch_dma_buffer(uint8_t line_end_flag) {
         DMA_set_memory_address(DMA_INSTANCE_TIC, DMA_CHANNEL_TIC, (uint32_t) &(tic_ctx.dma_buffer1), TIC_RX_BUFFER_SIZE);
         tic_ctx.flags.fill_buffer0 = 0;
     }
+    // The previous buffer has not been processed yet and is now overwritten by the DMA.
+    if (tic_ctx.flags.buffer_received != 0) {
+        tic_ctx.flags.buffer_overrun = 1;
+        tic_ctx.buffer_overrun_count++;
+    }
     // Update flags.
     tic_ctx.flags.irq_received = 1;
-    tic_ctx.flags.frame_received = line_end_flag;
+    tic_ctx.flags.buffer_received = 1;
     tic_ctx.second_count_inactivity = 0;
     // Restart DMA transfer.
     DMA_start(DMA_INSTANCE_TIC, DMA_CHANNEL_TIC);
@@ -138,7 +190,8 @@ static void _TIC_switch_dma_buffer(uint8_t line_end_flag) {
 /*******************************************************************/
 static void _TIC_usart_cm_irq_callback(void) {
     // Switch buffer.
-    _TIC_switch_dma_buffer(1);
+    _TIC_switch_dma_buffer();
+    tic_ctx.process_callback();
 }
 #endif
 
@@ -146,82 +199,184 @@ static void _TIC_usart_cm_irq_callback(void) {
 /*******************************************************************/
 static void _TIC_dma_tc_irq_callback(void) {
     // Switch buffer.
-    _TIC_switch_dma_buffer(0);
+    _TIC_switch_dma_buffer();
+    tic_ctx.process_callback();
 }
 #endif
 
 #ifdef MPMCM_LINKY_TIC_ENABLE
 /*******************************************************************/
-static void _TIC_build_frame(void) {
+static uint8_t _TIC_parse_decimal(char_t* str, uint8_t size, int32_t* value) {
     // Local variables.
-    uint32_t idx = 0;
-    uint8_t frame_end_char_found = 0;
-    // Reset frame size.
-    tic_ctx.frame_size = 0;
-    // Copy from buffer 0.
-    for (idx = 0; idx < TIC_RX_BUFFER_SIZE; idx++) {
-        // Copy from free buffer.
-        if (frame_end_char_found != 0) {
-            tic_ctx.frame[idx] = 0;
-        }
-        else {
-            // Copy from free buffer.
-            tic_ctx.frame[idx] = (tic_ctx.flags.fill_buffer0 == 0) ? tic_ctx.dma_buffer0[idx] : tic_ctx.dma_buffer1[idx];
-            // Remove parity bit.
-            tic_ctx.frame[idx] &= 0x7F;
-            // Increment size.
-            tic_ctx.frame_size++;
-        }
-        // Check line end character.
-        if (tic_ctx.frame[idx] == TIC_FRAME_END_CHAR) {
-            frame_end_char_found = 1;
-        }
+    uint8_t success = 0;
+    uint8_t idx = 0;
+    // Reset output.
+    (*value) = 0;
+    // Characters loop.
+    for (idx = 0; idx < size; idx++) {
+        // Check character.
+        if ((str[idx] < '0') || (str[idx] > '9')) goto errors;
+        (*value) = ((*value) * 10) + (int32_t) (str[idx] - '0');
     }
+    success = (size > 0) ? 1 : 0;
+errors:
+    return success;
 }
 #endif
 
+#ifdef MPMCM_LINKY_TIC_ENABLE
 /*******************************************************************/
-static void _TIC_reset_parser(void) {
-    // Reset parser.
-    tic_ctx.parser.buffer = (char_t*) tic_ctx.frame;
-    tic_ctx.parser.buffer_size = tic_ctx.frame_size;
-    tic_ctx.parser.separator_index = 0;
-    tic_ctx.parser.start_index = 0;
+static void _TIC_update_sample(TIC_sample_index_t sample_index, int32_t sample) {
+    // Local variables.
+    float64_t sample_abs = 0.0;
+    float64_t ref_abs = 0.0;
+    // Check index.
+    switch (sample_index) {
+    case TIC_SAMPLE_INDEX_APPARENT_POWER_VA:
+        // Update run data.
+        tic_data.run.apparent_power_mva.value = ((float64_t) sample * 1000.0);
+        tic_data.run.apparent_power_mva.number_of_samples = 1;
+        // Update accumulated.
+        DATA_add_accumulated_channel_sample(tic_data.accumulated, apparent_power_mva, tic_data.run.apparent_power_mva);
+        // Increase apparent energy.
+        tic_data.apparent_energy_mvas_sum.value += (tic_data.run.apparent_power_mva.value);
+        tic_data.apparent_energy_mvas_sum.number_of_samples++;
+        break;
+    case TIC_SAMPLE_INDEX_RMS_VOLTAGE_V:
+        // Update run data.
+        tic_data.run.rms_voltage_mv.value = ((float64_t) sample * 1000.0);
+        tic_data.run.rms_voltage_mv.number_of_samples = 1;
+        // Update accumulated.
+        DATA_add_accumulated_channel_sample(tic_data.accumulated, rms_voltage_mv, tic_data.run.rms_voltage_mv);
+        break;
+    case TIC_SAMPLE_INDEX_RMS_CURRENT_A:
+        // Update run data.
+        tic_data.run.rms_current_ma.value = ((float64_t) sample * 1000.0);
+        tic_data.run.rms_current_ma.number_of_samples = 1;
+        // Update accumulated.
+        DATA_add_accumulated_channel_sample(tic_data.accumulated, rms_current_ma, tic_data.run.rms_current_ma);
+        break;
+    case TIC_SAMPLE_INDEX_ENERGY_INDEX_WH:
+        // Update index.
+        tic_data.energy_index_wh.value = (float64_t) sample;
+        tic_data.energy_index_wh.number_of_samples = 1;
+        break;
+    default:
+        break;
+    }
 }
+#endif
 
 #ifdef MPMCM_LINKY_TIC_ENABLE
 /*******************************************************************/
-static TIC_status_t _TIC_decode_sample(TIC_sample_index_t sample_index) {
+static void _TIC_decode_group(void) {
     // Local variables.
-    TIC_status_t status = TIC_SUCCESS;
-    PARSER_status_t parser_status = PARSER_SUCCESS;
+    char_t checksum = 0;
+    uint32_t sum = 0;
+    uint8_t label_size = 0;
+    uint8_t value_start = 0;
+    uint8_t value_end = 0;
+    uint8_t sample_index = 0;
+    uint8_t idx = 0;
     int32_t sample = 0;
-    float64_t sample_abs = 0.0;
-    float64_t ref_abs = 0.0;
-    // Check index.
-    if (sample_index >= TIC_SAMPLE_INDEX_LAST) {
-        status = TIC_ERROR_DATA_INDEX;
+    // Check size and checksum separator.
+    if ((tic_ctx.parser_flags.group_overflow != 0) || (tic_ctx.group_size < TIC_GROUP_SIZE_MIN)) goto errors;
+    if (tic_ctx.group[tic_ctx.group_size - 2] != TIC_GROUP_SEPARATOR_CHAR) goto errors;
+    // Compute checksum.
+    // Note: the last separator is included in standard mode and excluded in historic mode.
+    checksum = tic_ctx.group[tic_ctx.group_size - 1];
+    sum = (tic_ctx.group_sum - (uint32_t) checksum);
+#ifdef MPMCM_LINKY_TIC_MODE_HISTORIC
+    sum -= (uint32_t) TIC_GROUP_SEPARATOR_CHAR;
+#endif
+    if ((char_t) ((sum & TIC_CHECKSUM_MASK) + TIC_CHECKSUM_OFFSET) != checksum) {
+        tic_ctx.checksum_error_count++;
         goto errors;
     }
-    // Decode apparent power.
-    if (PARSER_compare(&tic_ctx.parser, PARSER_MODE_HEADER, TIC_SAMPLE[sample_index].name) == PARSER_SUCCESS) {
-        // Get value.
-        parser_status = PARSER_get_parameter(&tic_ctx.parser, STRING_FORMAT_DECIMAL, TIC_FRAME_SEPARATOR_CHAR, &sample);
-        if (parser_status == PARSER_SUCCESS) {
-            // Update run data.
-            tic_data.run.apparent_power_mva.value = ((float64_t) (sample * 1000));
-            tic_data.run.apparent_power_mva.number_of_samples = 1;
-            // Update accumulated.
-            DATA_add_accumulated_channel_sample(tic_data.accumulated, apparent_power_mva, tic_data.run.apparent_power_mva);
-            // Increase apparent energy.
-            tic_data.apparent_energy_mvas_sum.value += (tic_data.run.apparent_power_mva.value);
-            tic_data.apparent_energy_mvas_sum.number_of_samples++;
-            // Set flag.
-            tic_ctx.flags.decode_success = 1;
+    // Search label end.
+    while (tic_ctx.group[label_size] != TIC_GROUP_SEPARATOR_CHAR) {
+        label_size++;
+    }
+    // Value is the last field before checksum (the optional timestamp field is skipped in standard mode).
+    value_end = (tic_ctx.group_size - 2);
+    value_start = value_end;
+    while ((value_start > label_size) && (tic_ctx.group[value_start - 1] != TIC_GROUP_SEPARATOR_CHAR)) {
+        value_start--;
+    }
+    // Search label in table.
+    for (sample_index = 0; sample_index < TIC_SAMPLE_INDEX_LAST; sample_index++) {
+        // Check label availability in the current mode.
+        if (TIC_SAMPLE[sample_index].label == NULL) continue;
+        // Compare label.
+        for (idx = 0; idx < label_size; idx++) {
+            if (TIC_SAMPLE[sample_index].label[idx] != tic_ctx.group[idx]) break;
         }
+        if ((idx != label_size) || (TIC_SAMPLE[sample_index].label[idx] != STRING_CHAR_NULL)) continue;
+        // Parse value.
+        if (_TIC_parse_decimal(&(tic_ctx.group[value_start]), (uint8_t) (value_end - value_start), &sample) == 0) goto errors;
+        // Update data.
+        _TIC_update_sample(sample_index, sample);
+        tic_ctx.parser_flags.group_decoded = 1;
+        break;
     }
 errors:
-    return status;
+    return;
+}
+#endif
+
+#ifdef MPMCM_LINKY_TIC_ENABLE
+/*******************************************************************/
+static void _TIC_parse_buffer(volatile char_t* buffer, uint8_t buffer_size) {
+    // Local variables.
+    char_t tic_char = 0;
+    uint8_t idx = 0;
+    // Characters loop.
+    for (idx = 0; idx < buffer_size; idx++) {
+        // Remove parity bit.
+        tic_char = (buffer[idx] & 0x7F);
+        // Check character.
+        switch (tic_char) {
+        case TIC_FRAME_START_CHAR:
+            // Reset group.
+            tic_ctx.parser_flags.group_started = 0;
+            break;
+        case TIC_FRAME_END_CHAR:
+            // Update frame status.
+            tic_ctx.frame_count++;
+            if (tic_ctx.parser_flags.group_decoded != 0) {
+                tic_ctx.parser_flags.decode_success = 1;
+            }
+            tic_ctx.parser_flags.group_started = 0;
+            break;
+        case TIC_GROUP_START_CHAR:
+            // Start new group.
+            tic_ctx.group_size = 0;
+            tic_ctx.group_sum = 0;
+            tic_ctx.parser_flags.group_overflow = 0;
+            tic_ctx.parser_flags.group_started = 1;
+            break;
+        case TIC_GROUP_END_CHAR:
+            // Decode group.
+            if (tic_ctx.parser_flags.group_started != 0) {
+                _TIC_decode_group();
+            }
+            tic_ctx.parser_flags.group_started = 0;
+            break;
+        default:
+            // Ignore characters outside of a group.
+            if (tic_ctx.parser_flags.group_started == 0) break;
+            // Store character.
+            if (tic_ctx.group_size < TIC_GROUP_BUFFER_SIZE) {
+                tic_ctx.group[tic_ctx.group_size] = tic_char;
+                tic_ctx.group_size++;
+                tic_ctx.group_sum += (uint32_t) tic_char;
+            }
+            else {
+                tic_ctx.parser_flags.group_overflow = 1;
+            }
+            break;
+        }
+    }
 }
 #endif
 
@@ -237,7 +392,8 @@ static TIC_status_t _TIC_start(void) {
     // Clear flags.
     tic_ctx.flags.all = 0;
     tic_ctx.flags.fill_buffer0 = 1;
-    tic_ctx.decoding_count = 0;
+    tic_ctx.parser_flags.all = 0;
+    tic_ctx.frame_count = 0;
     // Start with buffer 1.
     dma_status = DMA_set_memory_address(DMA_INSTANCE_TIC, DMA_CHANNEL_TIC, (uint32_t) &(tic_ctx.dma_buffer0), TIC_RX_BUFFER_SIZE);
     DMA_exit_error(TIC_ERROR_BASE_DMA);
@@ -272,7 +428,7 @@ static TIC_status_t _TIC_stop(void) {
 /*** TIC functions ***/
 
 /*******************************************************************/
-TIC_status_t TIC_init(void) {
+TIC_status_t TIC_init(TIC_process_cb_t process_callback) {
     // Local variables.
     TIC_status_t status = TIC_SUCCESS;
 #ifdef MPMCM_LINKY_TIC_ENABLE
@@ -283,23 +439,36 @@ TIC_status_t TIC_init(void) {
     uint32_t usart_rdr_register_address = 0;
 #endif
     uint32_t idx = 0;
+    // Check parameter.
+    if (process_callback == NULL) {
+        status = TIC_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
     // Init context.
     tic_ctx.state = TIC_STATE_OFF;
+    tic_ctx.process_callback = process_callback;
     tic_ctx.sampling_period_seconds = TIC_SAMPLING_PERIOD_SECONDS_DEFAULT;
     tic_ctx.second_count_sampling = 0;
     tic_ctx.second_count_period = 0;
     tic_ctx.second_count_inactivity = (TIC_INACTIVITY_TIMER_SECONDS << 1);
     tic_ctx.flags.all = 0;
+    tic_ctx.parser_flags.all = 0;
     for (idx = 0; idx < TIC_RX_BUFFER_SIZE; idx++)
         tic_ctx.dma_buffer0[idx] = 0;
     for (idx = 0; idx < TIC_RX_BUFFER_SIZE; idx++)
         tic_ctx.dma_buffer1[idx] = 0;
-    _TIC_reset_parser();
+    tic_ctx.dma_buffer_size = 0;
+    tic_ctx.group_size = 0;
+    tic_ctx.group_sum = 0;
+    tic_ctx.frame_count = 0;
+    tic_ctx.checksum_error_count = 0;
+    tic_ctx.buffer_overrun_count = 0;
     // Reset data.
     DATA_reset_run_channel(tic_data.run);
     DATA_reset_accumulated_channel(tic_data.accumulated);
     DATA_reset_run(tic_data.active_energy_mws_sum);
     DATA_reset_run(tic_data.apparent_energy_mvas_sum);
+    DATA_reset_run(tic_data.energy_index_wh);
 #ifdef MPMCM_LINKY_TIC_ENABLE
     // Init USART interface.
     usart_config.clock = RCC_CLOCK_HSI;
@@ -309,7 +478,7 @@ TIC_status_t TIC_init(void) {
     usart_config.nvic_priority = NVIC_PRIORITY_TIC;
     usart_config.rxne_irq_callback = NULL;
     usart_config.cm_irq_callback = &_TIC_usart_cm_irq_callback;
-    usart_config.match_character = TIC_FRAME_END_CHAR;
+    usart_config.match_character = TIC_GROUP_START_CHAR;
     usart_status = USART_init(USART_INSTANCE_TIC, &USART_GPIO_TIC, &usart_config);
     USART_exit_error(TIC_ERROR_BASE_USART);
     usart_status = USART_get_rdr_register_address(USART_INSTANCE_TIC, &usart_rdr_register_address);
@@ -360,6 +529,11 @@ TIC_status_t TIC_process(void) {
     LED_status_t led_status = LED_SUCCESS;
     LED_color_t led_color = LED_COLOR_OFF;
 #endif
+    volatile char_t* buffer = NULL;
+    uint8_t buffer_size = 0;
+    uint8_t buffer_received = 0;
+    uint8_t buffer_overrun = 0;
+    uint32_t primask = 0;
     // Perform state machine.
     switch (tic_ctx.state) {
     case TIC_STATE_OFF:
@@ -376,20 +550,28 @@ TIC_status_t TIC_process(void) {
         }
         break;
     case TIC_STATE_ACTIVE:
-        if (tic_ctx.flags.frame_received != 0) {
+        // Read the last received buffer with interrupts masked, since the USART and DMA handlers switch buffers and update the same flags.
+        CRITICAL_enter(primask);
+        buffer_received = tic_ctx.flags.buffer_received;
+        if (buffer_received != 0) {
             // Clear flag.
-            tic_ctx.flags.frame_received = 0;
-            // Build frame.
-            _TIC_build_frame();
-            _TIC_reset_parser();
-            // Decode data.
-            status = _TIC_decode_sample(TIC_SAMPLE_INDEX_APPARENT_POWER_VA);
-            if (status != TIC_SUCCESS) goto errors;
-            // Increment decoding count.
-            tic_ctx.decoding_count++;
+            tic_ctx.flags.buffer_received = 0;
+            buffer = (tic_ctx.flags.fill_buffer0 == 0) ? tic_ctx.dma_buffer0 : tic_ctx.dma_buffer1;
+            buffer_size = tic_ctx.dma_buffer_size;
+            buffer_overrun = tic_ctx.flags.buffer_overrun;
+            tic_ctx.flags.buffer_overrun = 0;
+        }
+        CRITICAL_exit(primask);
+        if (buffer_received != 0) {
+            // Drop the group in progress since its next characters were in the overwritten buffer.
+            if (buffer_overrun != 0) {
+                tic_ctx.parser_flags.group_started = 0;
+            }
+            // Decode all groups of the buffer.
+            _TIC_parse_buffer(buffer, buffer_size);
         }
         // Check exit conditions.
-        if ((tic_ctx.flags.decode_success != 0) || (tic_ctx.decoding_count > (TIC_NUMBER_OF_DATA << 1)) || (tic_ctx.second_count_sampling >= TIC_SAMPLING_TIMEOUT_SECONDS)) {
+        if ((tic_ctx.parser_flags.decode_success != 0) || (tic_ctx.frame_count > TIC_NUMBER_OF_FRAMES_MAX) || (tic_ctx.second_count_sampling >= TIC_SAMPLING_TIMEOUT_SECONDS)) {
             // Update state.
             tic_ctx.state = TIC_STATE_OFF;
             // Stop acquisition.
@@ -401,7 +583,7 @@ TIC_status_t TIC_process(void) {
                 led_color = LED_COLOR_RED;
             }
             else {
-                led_color = (tic_ctx.flags.decode_success) ? LED_COLOR_GREEN : LED_COLOR_YELLOW;
+                led_color = (tic_ctx.parser_flags.decode_success) ? LED_COLOR_GREEN : LED_COLOR_YELLOW;
             }
             led_status = LED_single_pulse(TIC_LED_PULSE_DURATION_US, led_color, 1);
             LED_exit_error(TIC_ERROR_BASE_LED);
@@ -487,6 +669,48 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+TIC_status_t TIC_get_energy_index(DATA_run_t* energy_index_wh) {
+    // Local variables.
+    TIC_status_t status = TIC_SUCCESS;
+    // Check parameter.
+    if (energy_index_wh == NULL) {
+        status = TIC_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    DATA_copy_run(tic_data.energy_index_wh, (*energy_index_wh));
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TIC_status_t TIC_get_checksum_error_count(uint32_t* checksum_error_count) {
+    // Local variables.
+    TIC_status_t status = TIC_SUCCESS;
+    // Check parameter.
+    if (checksum_error_count == NULL) {
+        status = TIC_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*checksum_error_count) = tic_ctx.checksum_error_count;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TIC_status_t TIC_get_buffer_overrun_count(uint32_t* buffer_overrun_count) {
+    // Local variables.
+    TIC_status_t status = TIC_SUCCESS;
+    // Check parameter.
+    if (buffer_overrun_count == NULL) {
+        status = TIC_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*buffer_overrun_count) = tic_ctx.buffer_overrun_count;
+errors:
+    return status;
+}
+
 /*******************************************************************/
 TIC_status_t TIC_get_channel_accumulated_data(DATA_accumulated_channel_t* channel_accumulated_data) {
     // Local variables.
@@ -0,0 +1,28 @@
+/*
+ * critical.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __CRITICAL_H__
+#define __CRITICAL_H__
+
+#include "types.h"
+
+/*** CRITICAL macros ***/
+
+/*******************************************************************/
+#define CRITICAL_enter(primask) { \
+    /* Save interrupts state and mask all interrupts */ \
+    __asm volatile ("mrs %0, primask" : "=r" (primask) :: "memory"); \
+    __asm volatile ("cpsid i" ::: "memory"); \
+}
+
+/*******************************************************************/
+#define CRITICAL_exit(primask) { \
+    /* Restore interrupts state */ \
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory"); \
+}
+
+#endif /* __CRITICAL_H__ */
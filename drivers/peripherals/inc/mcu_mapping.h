@@ -113,6 +113,7 @@
 #define TIM_CHANNEL_LED_RED             TIM_CHANNEL_2
 #define TIM_CHANNEL_LED_GREEN           TIM_CHANNEL_3
 #define TIM_CHANNEL_LED_BLUE            TIM_CHANNEL_1
+#define TIM_INSTANCE_RELAY              TIM_INSTANCE_TIM22
 #endif
 #ifdef DDRM
 #define TIM_INSTANCE_LED                TIM_INSTANCE_TIM2
@@ -151,6 +152,9 @@
 #endif
 
 #define TIM_INSTANCE_MCU_API            TIM_INSTANCE_TIM2
+#ifdef UHFM
+#define TIM_INSTANCE_RADIO_BUSY         TIM_INSTANCE_TIM22
+#endif
 
 #define USART_INSTANCE_GPS              USART_INSTANCE_USART2
 
@@ -47,9 +47,15 @@ typedef enum {
 #ifdef DSM_RGB_LED
     NVIC_PRIORITY_LED = 1,
 #endif
+#if ((defined LVRM) && (defined HW2_0))
+    NVIC_PRIORITY_RELAY = 1,
+#endif
 #ifdef UHFM
     NVIC_PRIORITY_SIGFOX_RADIO_IRQ_GPIO = 0,
     NVIC_PRIORITY_SIGFOX_TIMER = 1,
+    // Busy and DIO1 pins share the same EXTI line.
+    NVIC_PRIORITY_RADIO_BUSY = NVIC_PRIORITY_SIGFOX_RADIO_IRQ_GPIO,
+    NVIC_PRIORITY_RADIO_BUSY_TIMER = 1,
 #endif
 #ifdef GPSM
     NVIC_PRIORITY_GPS_UART = 0,
@@ -20,6 +20,9 @@ typedef enum {
     NVM_ADDRESS_SIGFOX_EP_KEY = (NVM_ADDRESS_SIGFOX_EP_ID + SIGFOX_EP_ID_SIZE_BYTES),
     NVM_ADDRESS_SIGFOX_EP_LIB_DATA = (NVM_ADDRESS_SIGFOX_EP_KEY + SIGFOX_EP_KEY_SIZE_BYTES),
     NVM_ADDRESS_UNA_REGISTERS = 0x40,
+    NVM_ADDRESS_ERROR_LOG = 0x180,
+    NVM_ADDRESS_ENERGY_CHECKPOINT = 0x1C0,
+    NVM_ADDRESS_UHFM_UPLINK_QUEUE = 0x200,
 } NVM_address_mapping_t;
 
 #endif /* __NVM_ADDRESS_H__ */
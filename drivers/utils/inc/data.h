@@ -8,6 +8,7 @@
 #ifndef __DATA_H__
 #define __DATA_H__
 
+#include "maths.h"
 #include "types.h"
 
 /*** DATA macros ***/
@@ -25,6 +26,15 @@ typedef struct {
     uint32_t number_of_samples;
 } DATA_run_t;
 
+/*!******************************************************************
+ * \struct DATA_rolling_t
+ * \brief Single precision rolling mean structure.
+ *******************************************************************/
+typedef struct {
+    float32_t value;
+    uint32_t number_of_samples;
+} DATA_rolling_t;
+
 /*!******************************************************************
  * \struct DATA_accumulated_t
  * \brief Single accumulated data structure.
@@ -48,6 +58,18 @@ typedef struct {
     DATA_run_t power_factor;
 } DATA_run_channel_t;
 
+/*!******************************************************************
+ * \struct DATA_rolling_channel_t
+ * \brief Single channel single precision rolling means structure.
+ *******************************************************************/
+typedef struct {
+    DATA_rolling_t active_power_mw;
+    DATA_rolling_t rms_voltage_mv;
+    DATA_rolling_t rms_current_ma;
+    DATA_rolling_t apparent_power_mva;
+    DATA_rolling_t power_factor;
+} DATA_rolling_channel_t;
+
 /*!******************************************************************
  * \struct DATA_accumulated_channel_t
  * \brief Single channel accumulated data structure.
@@ -144,6 +166,18 @@ typedef struct {
     MATH_rolling_mean(channel.data.value, channel.data.number_of_samples, sample, float64_t); \
 }
 
+/*******************************************************************/
+#define DATA_add_rolling_sample(data, sample) { \
+    /* Incremental mean update (no running sum which would lose precision) */ \
+    data.number_of_samples++; \
+    data.value += ((((float32_t) (sample)) - data.value) / ((float32_t) data.number_of_samples)); \
+}
+
+/*******************************************************************/
+#define DATA_add_rolling_channel_sample(channel, data, sample) { \
+    DATA_add_rolling_sample(channel.data, sample); \
+}
+
 /*******************************************************************/
 #define DATA_add_accumulated_sample(data, source) { \
     /* Check source data */ \
@@ -113,6 +113,16 @@ ANALOG_status_t ANALOG_de_init(void);
  *******************************************************************/
 ANALOG_status_t ANALOG_convert_channel(ANALOG_channel_t channel, int32_t* analog_data);
 
+/*!******************************************************************
+ * \fn ANALOG_status_t ANALOG_convert_channels(const ANALOG_channel_t* channel_list, uint8_t number_of_channels, int32_t* analog_data)
+ * \brief Convert a list of analog channels with the last MCU voltage measurement (ANALOG_CHANNEL_MCU_VOLTAGE_MV has to be converted before).
+ * \param[in]   channel_list: List of channels to convert.
+ * \param[in]   number_of_channels: Number of channels in the list.
+ * \param[out]  analog_data: Pointer to the integer array that will contain the results.
+ * \retval      Function execution status.
+ *******************************************************************/
+ANALOG_status_t ANALOG_convert_channels(const ANALOG_channel_t* channel_list, uint8_t number_of_channels, int32_t* analog_data);
+
 /*******************************************************************/
 #define ANALOG_exit_error(base) { ERROR_check_exit(analog_status, ANALOG_SUCCESS, base) }
 
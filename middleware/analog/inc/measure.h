@@ -16,6 +16,7 @@
 #include "error.h"
 #include "led.h"
 #include "maths.h"
+#include "nvm.h"
 #include "power.h"
 #include "rcc.h"
 #include "tim.h"
@@ -30,6 +31,12 @@
 
 #define MEASURE_PERIOD_BUFFER_SIZE          (MEASURE_MAINS_PERIOD_US / MEASURE_ACV_ACI_SAMPLING_PERIOD_US)
 
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+// Highest harmonic rank computed on each period (the fundamental is rank 1).
+#define MEASURE_HARMONICS_RANK_MAX          7
+#define MEASURE_NUMBER_OF_HARMONICS         (MEASURE_HARMONICS_RANK_MAX - 1)
+#endif
+
 /*** MEASURE global variables ***/
 
 extern const uint8_t MEASURE_CURRENT_SENSOR_ATTENUATOR[MEASURE_NUMBER_OF_ACI_CHANNELS];
@@ -58,8 +65,9 @@ typedef enum {
     MEASURE_ERROR_BASE_MATH = (MEASURE_ERROR_BASE_RCC + RCC_ERROR_BASE_LAST),
     MEASURE_ERROR_BASE_POWER = (MEASURE_ERROR_BASE_MATH + MATH_ERROR_BASE_LAST),
     MEASURE_ERROR_BASE_LED = (MEASURE_ERROR_BASE_POWER + POWER_ERROR_BASE_LAST),
+    MEASURE_ERROR_BASE_NVM = (MEASURE_ERROR_BASE_LED + LED_ERROR_BASE_LAST),
     // Last base value.
-    MEASURE_ERROR_BASE_LAST = (MEASURE_ERROR_BASE_LED + LED_ERROR_BASE_LAST)
+    MEASURE_ERROR_BASE_LAST = (MEASURE_ERROR_BASE_NVM + NVM_ERROR_BASE_LAST)
 } MEASURE_status_t;
 
 /*!******************************************************************
@@ -83,6 +91,46 @@ typedef enum {
     MEASURE_DATA_INDEX_LAST
 } MEASURE_data_index_t;
 
+/*!******************************************************************
+ * \struct MEASURE_period_queue_statistics_t
+ * \brief MEASURE periods queue statistics.
+ *******************************************************************/
+typedef struct {
+    uint32_t number_of_published_periods;
+    uint32_t number_of_dropped_periods;
+    uint32_t number_of_overwritten_periods;
+    uint32_t max_pending_periods;
+} MEASURE_period_queue_statistics_t;
+
+#ifdef MPMCM_ANALOG_MEASURE_PROFILING
+/*!******************************************************************
+ * \struct MEASURE_profiling_t
+ * \brief MEASURE period computation profiling data.
+ *******************************************************************/
+typedef struct {
+    uint32_t period_cycles_last;
+    uint32_t period_cycles_min;
+    uint32_t period_cycles_max;
+    uint32_t period_cycles_mean;
+    uint32_t number_of_periods;
+    uint32_t periods_per_second;
+} MEASURE_profiling_t;
+#endif
+
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+/*!******************************************************************
+ * \struct MEASURE_harmonics_data_t
+ * \brief Single channel harmonics run data structure.
+ *******************************************************************/
+typedef struct {
+    DATA_run_t voltage_thd_percent;
+    DATA_run_t current_thd_percent;
+    // Index 0 is the rank 2 harmonic, levels are given relatively to the fundamental.
+    DATA_run_t voltage_harmonic_percent[MEASURE_NUMBER_OF_HARMONICS];
+    DATA_run_t current_harmonic_percent[MEASURE_NUMBER_OF_HARMONICS];
+} MEASURE_harmonics_data_t;
+#endif
+
 /*** MEASURE functions ***/
 
 /*!******************************************************************
@@ -133,6 +181,17 @@ MEASURE_status_t MEASURE_set_gains(uint16_t transformer_gain, uint16_t current_s
 MEASURE_status_t MEASURE_tick_second(void);
 #endif
 
+#ifdef MPMCM_ANALOG_MEASURE_ENABLE
+/*!******************************************************************
+ * \fn MEASURE_status_t MEASURE_process(void)
+ * \brief Compute the periods published by the zero cross interrupt.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+MEASURE_status_t MEASURE_process(void);
+#endif
+
 /*!******************************************************************
  * \fn MEASURE_status_t MEASURE_get_probe_detect_flag(uint8_t channel_index, uint8_t* current_probe_connected)
  * \brief Get AC channel detect flag.
@@ -187,6 +246,49 @@ MEASURE_status_t MEASURE_get_channel_run_data(uint8_t channel, DATA_run_channel_
  *******************************************************************/
 MEASURE_status_t MEASURE_get_channel_accumulated_data(uint8_t channel, DATA_accumulated_channel_t* channel_accumulated_data);
 
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS))
+/*!******************************************************************
+ * \fn MEASURE_status_t MEASURE_get_channel_energy_total(uint8_t channel, int32_t* active_energy_wh, int32_t* apparent_energy_vah)
+ * \brief Get AC channel energy totals since the last NVM reset (never cleared on read).
+ * \param[in]   channel: AC channel index to read.
+ * \param[out]  active_energy_wh: Pointer to the active energy total in Wh.
+ * \param[out]  apparent_energy_vah: Pointer to the apparent energy total in VAh.
+ * \retval      Function execution status.
+ *******************************************************************/
+MEASURE_status_t MEASURE_get_channel_energy_total(uint8_t channel, int32_t* active_energy_wh, int32_t* apparent_energy_vah);
+#endif
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ANALOG_MEASURE_HARMONICS))
+/*!******************************************************************
+ * \fn MEASURE_status_t MEASURE_get_channel_harmonics_data(uint8_t channel, MEASURE_harmonics_data_t* channel_harmonics_data)
+ * \brief Get AC channel harmonics run data.
+ * \param[in]   channel: AC channel index to read.
+ * \param[out]  channel_harmonics_data: Pointer to the channel harmonics results.
+ * \retval      Function execution status.
+ *******************************************************************/
+MEASURE_status_t MEASURE_get_channel_harmonics_data(uint8_t channel, MEASURE_harmonics_data_t* channel_harmonics_data);
+#endif
+
+/*!******************************************************************
+ * \fn MEASURE_status_t MEASURE_get_period_queue_statistics(MEASURE_period_queue_statistics_t* period_queue_statistics)
+ * \brief Get periods queue statistics.
+ * \param[in]   none
+ * \param[out]  period_queue_statistics: Pointer to the periods queue statistics.
+ * \retval      Function execution status.
+ *******************************************************************/
+MEASURE_status_t MEASURE_get_period_queue_statistics(MEASURE_period_queue_statistics_t* period_queue_statistics);
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ANALOG_MEASURE_PROFILING))
+/*!******************************************************************
+ * \fn MEASURE_status_t MEASURE_get_profiling_data(MEASURE_profiling_t* profiling_data)
+ * \brief Get period computation profiling data.
+ * \param[in]   none
+ * \param[out]  profiling_data: Pointer to the profiling data.
+ * \retval      Function execution status.
+ *******************************************************************/
+MEASURE_status_t MEASURE_get_profiling_data(MEASURE_profiling_t* profiling_data);
+#endif
+
 /*******************************************************************/
 #define MEASURE_exit_error(base) { ERROR_check_exit(measure_status, MEASURE_SUCCESS, base) }
 
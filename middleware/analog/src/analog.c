@@ -153,6 +153,7 @@ ANALOG_status_t ANALOG_convert_channel(ANALOG_channel_t channel, int32_t* analog
 #endif
 #if ((defined SM) && (defined SM_AIN_ENABLE))
     uint8_t ainx_index = 0;
+    int64_t ainx_mv = 0;
 #endif
     // Check parameter.
     if (analog_data == NULL) {
@@ -328,12 +329,13 @@ ANALOG_status_t ANALOG_convert_channel(ANALOG_channel_t channel, int32_t* analog
         adc_status = ADC_convert_channel(ANALOG_CHANNEL_CONFIGURATION[ainx_index].adc_channel, &adc_data_12bits);
         ADC_exit_error(ANALOG_ERROR_BASE_ADC);
         // Apply gain.
+        ainx_mv = ((int64_t) adc_data_12bits) * ((int64_t) analog_ctx.mcu_voltage_mv);
         switch (ANALOG_CHANNEL_CONFIGURATION[ainx_index].gain_type) {
         case ANALOG_GAIN_TYPE_ATTENUATION:
-            (*analog_data) = (adc_data_12bits * analog_ctx.mcu_voltage_mv * ANALOG_CHANNEL_CONFIGURATION[ainx_index].gain) / (ADC_FULL_SCALE);
+            (*analog_data) = (int32_t) ((ainx_mv * ANALOG_CHANNEL_CONFIGURATION[ainx_index].gain) / (ADC_FULL_SCALE));
             break;
         case ANALOG_GAIN_TYPE_AMPLIFICATION:
-            (*analog_data) = (adc_data_12bits * analog_ctx.mcu_voltage_mv) / (ADC_FULL_SCALE * ANALOG_CHANNEL_CONFIGURATION[ainx_index].gain);
+            (*analog_data) = (int32_t) (ainx_mv / (ADC_FULL_SCALE * ANALOG_CHANNEL_CONFIGURATION[ainx_index].gain));
             break;
         default:
             status = ANALOG_ERROR_GAIN_TYPE;
@@ -357,3 +359,27 @@ ANALOG_status_t ANALOG_convert_channel(ANALOG_channel_t channel, int32_t* analog
 errors:
     return status;
 }
+
+/*******************************************************************/
+ANALOG_status_t ANALOG_convert_channels(const ANALOG_channel_t* channel_list, uint8_t number_of_channels, int32_t* analog_data) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    uint8_t idx = 0;
+    // Check parameters.
+    if ((channel_list == NULL) || (analog_data == NULL)) {
+        status = ANALOG_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Channels loop (all channels use the last MCU voltage measurement).
+    for (idx = 0; idx < number_of_channels; idx++) {
+        // Reference channel is not converted again.
+        if (channel_list[idx] == ANALOG_CHANNEL_MCU_VOLTAGE_MV) {
+            analog_data[idx] = analog_ctx.mcu_voltage_mv;
+            continue;
+        }
+        status = ANALOG_convert_channel(channel_list[idx], &(analog_data[idx]));
+        if (status != ANALOG_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
@@ -13,12 +13,14 @@
 #include "stm32g4xx_drivers_flags.h"
 #endif
 #include "adc.h"
+#include "critical.h"
 #include "data.h"
 #include "dma.h"
 #include "dmamux.h"
 #include "dsm_flags.h"
 #include "dsm_flags_slave.h"
 #include "dsp/basic_math_functions.h"
+#include "dsp/fast_math_functions.h"
 #include "dsp/statistics_functions.h"
 #include "error.h"
 #include "error_base.h"
@@ -29,8 +31,11 @@
 #include "mcu_mapping.h"
 #include "nvic.h"
 #include "nvic_priority.h"
+#include "nvm.h"
+#include "nvm_address.h"
 #include "power.h"
 #include "rcc.h"
+#include "scheduler.h"
 #include "simulation.h"
 #include "tim.h"
 #include "types.h"
@@ -49,12 +54,17 @@
 #define MEASURE_TRANSFORMER_GAIN_FACTOR                 10
 #define MEASURE_CURRENT_SENSOR_GAIN_FACTOR              10
 
-// Note: this factor is used to add a margin to the buffer length (more than 1 mains periods long).
-// Buffer switch then is triggered by zero cross detection instead of a fixed number of samples.
+// Note: this factor is used to add a margin to the period length (more than 1 mains periods long).
+// Period boundaries are then given by zero cross detection instead of a fixed number of samples.
 #define MEASURE_PERIOD_PER_BUFFER                       2
 #define MEASURE_PERIOD_ADCX_BUFFER_SIZE                 (MEASURE_PERIOD_PER_BUFFER * MEASURE_PERIOD_BUFFER_SIZE)
 #define MEASURE_PERIOD_ADCX_DMA_BUFFER_SIZE             (MEASURE_NUMBER_OF_ACI_CHANNELS * MEASURE_PERIOD_ADCX_BUFFER_SIZE)
-#define MEASURE_PERIOD_ADCX_DMA_BUFFER_DEPTH            2
+// Note: the circular buffers hold (MEASURE_PERIOD_QUEUE_SIZE + MEASURE_PERIOD_PER_BUFFER) nominal periods, which only covers the queued periods if they are computed in time.
+// Periods whose samples have been overwritten by the DMA before the end of their computation are discarded (see _MEASURE_check_period_samples).
+#define MEASURE_PERIOD_QUEUE_SIZE                       4 // Must be a power of 2.
+#define MEASURE_PERIOD_ADCX_DMA_BUFFER_DEPTH            ((MEASURE_PERIOD_QUEUE_SIZE + MEASURE_PERIOD_PER_BUFFER) / MEASURE_PERIOD_PER_BUFFER)
+// Circular buffers continuously filled by DMA.
+#define MEASURE_ADCX_DMA_BUFFER_SIZE                    (MEASURE_PERIOD_ADCX_DMA_BUFFER_DEPTH * MEASURE_PERIOD_ADCX_DMA_BUFFER_SIZE)
 #define MEASURE_PERIOD_TIMX_DMA_BUFFER_SIZE             3
 
 // Wait for 1 second of sampling before computing run and accumulated data.
@@ -74,6 +84,48 @@
 #define MEASURE_MAINS_DETECT_PERIOD_SECONDS             30
 #define MEASURE_MAINS_DETECT_TIMEOUT_SECONDS            2
 
+#ifdef MPMCM_ANALOG_MEASURE_PROFILING
+// Cortex-M4 debug registers used as cycle counter.
+#define MEASURE_PROFILING_DEMCR                         (*((volatile uint32_t*) 0xE000EDFC))
+#define MEASURE_PROFILING_DEMCR_TRCENA                  (0b1 << 24)
+#define MEASURE_PROFILING_DWT_CTRL                      (*((volatile uint32_t*) 0xE0001000))
+#define MEASURE_PROFILING_DWT_CTRL_CYCCNTENA            (0b1 << 0)
+#define MEASURE_PROFILING_DWT_CYCCNT                    (*((volatile uint32_t*) 0xE0001004))
+#endif
+
+#ifdef MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS
+#define MEASURE_ENERGY_MWS_PER_WH                       (1000.0 * DATA_SECONDS_PER_HOUR)
+// Checkpoints are written in a ring of slots to spread NVM wear.
+// Slot layout: sequence number, active energy totals, apparent energy totals and checksum.
+#define MEASURE_ENERGY_NVM_NUMBER_OF_SLOTS              4
+#define MEASURE_ENERGY_NVM_SLOT_SEQUENCE_WORD_INDEX     0
+#define MEASURE_ENERGY_NVM_SLOT_ACTIVE_WORD_INDEX       1
+#define MEASURE_ENERGY_NVM_SLOT_APPARENT_WORD_INDEX     (MEASURE_ENERGY_NVM_SLOT_ACTIVE_WORD_INDEX + MEASURE_NUMBER_OF_ACI_CHANNELS)
+#define MEASURE_ENERGY_NVM_SLOT_CHECKSUM_WORD_INDEX     (MEASURE_ENERGY_NVM_SLOT_APPARENT_WORD_INDEX + MEASURE_NUMBER_OF_ACI_CHANNELS)
+#define MEASURE_ENERGY_NVM_SLOT_SIZE_WORDS              (MEASURE_ENERGY_NVM_SLOT_CHECKSUM_WORD_INDEX + 1)
+#define MEASURE_ENERGY_NVM_CHECKSUM_SEED                0x454E5247
+#endif
+
+#ifdef MPMCM_DATA_SINGLE_PRECISION
+// Rolling means updated at every mains period use the FPU single precision.
+#define _MEASURE_add_rolling_sample(data, sample)                       DATA_add_rolling_sample(data, sample)
+#define _MEASURE_add_rolling_channel_sample(channel, data, sample)      DATA_add_rolling_channel_sample(channel, data, sample)
+#define MEASURE_FLOAT_ZERO                                              0.0f
+#define MEASURE_FLOAT_MINUS_ONE                                         (-1.0f)
+#define MEASURE_FLOAT_MILLI_DIVIDER                                     1000.0f
+#else
+#define _MEASURE_add_rolling_sample(data, sample)                       DATA_add_run_sample(data, sample)
+#define _MEASURE_add_rolling_channel_sample(channel, data, sample)      DATA_add_run_channel_sample(channel, data, sample)
+#define MEASURE_FLOAT_ZERO                                              0.0
+#define MEASURE_FLOAT_MINUS_ONE                                         (-1.0)
+#define MEASURE_FLOAT_MILLI_DIVIDER                                     1000.0
+#endif
+
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+#define MEASURE_HARMONICS_TWO_PI                        6.28318530718f
+#define MEASURE_HARMONICS_PERCENT_MULTIPLIER            100.0f
+#endif
+
 /*** MEASURE static functions declaration ***/
 
 #ifdef MPMCM_ANALOG_MEASURE_ENABLE
@@ -82,21 +134,59 @@ static MEASURE_status_t _MEASURE_internal_process(void);
 
 /*** MEASURE local structures ***/
 
+#ifdef MPMCM_DATA_SINGLE_PRECISION
+typedef float32_t MEASURE_float_t;
+typedef DATA_rolling_t MEASURE_rolling_t;
+typedef DATA_rolling_channel_t MEASURE_rolling_channel_t;
+#else
+typedef float64_t MEASURE_float_t;
+typedef DATA_run_t MEASURE_rolling_t;
+typedef DATA_run_channel_t MEASURE_rolling_channel_t;
+#endif
+
+/*******************************************************************/
+typedef struct {
+    uint16_t acv_start_idx;
+    uint16_t acv_size;
+    uint16_t aci_start_idx;
+    uint16_t aci_size;
+    uint32_t acv_start_count;
+    uint32_t aci_start_count;
+} MEASURE_period_t;
+
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+/*******************************************************************/
+typedef struct {
+    float32_t s1[MEASURE_HARMONICS_RANK_MAX];
+    float32_t s2[MEASURE_HARMONICS_RANK_MAX];
+} MEASURE_goertzel_t;
+#endif
+
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
 /*******************************************************************/
 typedef struct {
-    int16_t data[MEASURE_PERIOD_ADCX_DMA_BUFFER_SIZE];
-    uint16_t size;
-} MEASURE_buffer_t;
+    MEASURE_rolling_t voltage_thd_percent;
+    MEASURE_rolling_t current_thd_percent;
+    MEASURE_rolling_t voltage_harmonic_percent[MEASURE_NUMBER_OF_HARMONICS];
+    MEASURE_rolling_t current_harmonic_percent[MEASURE_NUMBER_OF_HARMONICS];
+} MEASURE_harmonics_rolling_t;
+#endif
 
 /*******************************************************************/
 typedef struct {
-    // Raw buffers filled by ADC and DMA for 1 period.
-    MEASURE_buffer_t acv[MEASURE_PERIOD_ADCX_DMA_BUFFER_DEPTH];
-    uint8_t acv_read_idx;
-    uint8_t acv_write_idx;
-    MEASURE_buffer_t aci[MEASURE_PERIOD_ADCX_DMA_BUFFER_DEPTH];
-    uint8_t aci_read_idx;
-    uint8_t aci_write_idx;
+    // Raw circular buffers continuously filled by ADC and DMA.
+    int16_t acv[MEASURE_ADCX_DMA_BUFFER_SIZE];
+    int16_t aci[MEASURE_ADCX_DMA_BUFFER_SIZE];
+    // Start indexes of the current period.
+    uint16_t acv_period_start_idx;
+    uint16_t aci_period_start_idx;
+    // Number of samples written by the DMA before the current period (used to detect overwritten periods).
+    uint32_t acv_period_start_count;
+    uint32_t aci_period_start_count;
+    // Completed periods queue (written under interrupt, read by the main context).
+    MEASURE_period_t period_queue[MEASURE_PERIOD_QUEUE_SIZE];
+    uint32_t period_queue_write_count;
+    uint32_t period_queue_read_count;
     // Raw buffer filled by timer and DMA.
     uint32_t acv_frequency_capture[MEASURE_PERIOD_TIMX_DMA_BUFFER_SIZE];
 } MEASURE_sampling_t;
@@ -104,16 +194,18 @@ typedef struct {
 /*******************************************************************/
 typedef struct {
     // Factors.
-    float64_t acv_factor_num;
-    float64_t acv_factor_den;
-    float64_t aci_factor_num[MEASURE_NUMBER_OF_ACI_CHANNELS];
-    float64_t aci_factor_den;
-    float64_t acp_factor_num[MEASURE_NUMBER_OF_ACI_CHANNELS];
-    float64_t acp_factor_den;
+    MEASURE_float_t acv_factor_num;
+    MEASURE_float_t acv_factor_den;
+    MEASURE_float_t aci_factor_num[MEASURE_NUMBER_OF_ACI_CHANNELS];
+    MEASURE_float_t aci_factor_den;
+    MEASURE_float_t acp_factor_num[MEASURE_NUMBER_OF_ACI_CHANNELS];
+    MEASURE_float_t acp_factor_den;
     // Temporary variables for individual channel processing on 1 period.
+#ifdef MPMCM_ANALOG_MEASURE_CMSIS_DSP
     float32_t period_acvx_buffer_f32[MEASURE_PERIOD_ADCX_BUFFER_SIZE];
     float32_t period_acix_buffer_f32[MEASURE_PERIOD_ADCX_BUFFER_SIZE];
     float32_t period_acpx_buffer_f32[MEASURE_PERIOD_ADCX_BUFFER_SIZE];
+#endif
     uint32_t period_acxx_buffer_size;
     uint32_t period_acxx_buffer_size_low_limit;
     uint32_t period_acxx_buffer_size_high_limit;
@@ -123,24 +215,48 @@ typedef struct {
     float32_t period_apparent_power_f32;
     float32_t period_power_factor_f32;
     // AC channels results.
-    DATA_run_channel_t chx_rolling_mean[MEASURE_NUMBER_OF_ACI_CHANNELS];
+    MEASURE_rolling_channel_t chx_rolling_mean[MEASURE_NUMBER_OF_ACI_CHANNELS];
     DATA_run_channel_t chx_run_data[MEASURE_NUMBER_OF_ACI_CHANNELS];
     DATA_accumulated_channel_t chx_accumulated_data[MEASURE_NUMBER_OF_ACI_CHANNELS];
     DATA_run_t active_energy_mws_sum[MEASURE_NUMBER_OF_ACI_CHANNELS];
     DATA_run_t apparent_energy_mvas_sum[MEASURE_NUMBER_OF_ACI_CHANNELS];
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+    // AC channels harmonics.
+    MEASURE_harmonics_rolling_t chx_harmonics_rolling_mean[MEASURE_NUMBER_OF_ACI_CHANNELS];
+    MEASURE_harmonics_data_t chx_harmonics_run_data[MEASURE_NUMBER_OF_ACI_CHANNELS];
+#endif
     // Mains frequency.
-    DATA_run_t acv_frequency_rolling_mean;
+    MEASURE_rolling_t acv_frequency_rolling_mean;
     DATA_run_t acv_frequency_run_data;
     DATA_accumulated_t acv_frequency_accumulated_data;
 } MEASURE_data_t;
 
+#ifdef MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS
+/*******************************************************************/
+typedef struct {
+    // Totals are kept across mains losses and restored from NVM at boot.
+    int32_t active_energy_wh_total[MEASURE_NUMBER_OF_ACI_CHANNELS];
+    int32_t apparent_energy_vah_total[MEASURE_NUMBER_OF_ACI_CHANNELS];
+    // Energy which does not reach 1Wh yet.
+    float64_t active_energy_mws_residual[MEASURE_NUMBER_OF_ACI_CHANNELS];
+    float64_t apparent_energy_mvas_residual[MEASURE_NUMBER_OF_ACI_CHANNELS];
+    uint32_t nvm_sequence_number;
+    uint8_t nvm_slot_index;
+    uint32_t checkpoint_seconds_count;
+    uint8_t checkpoint_pending;
+} MEASURE_energy_t;
+#endif
+
 /*******************************************************************/
 typedef struct {
     MEASURE_state_t state;
     uint8_t probe_detect_flag[MEASURE_NUMBER_OF_ACI_CHANNELS];
     uint8_t processing_enable;
     uint32_t zero_cross_count;
-    uint8_t dma_transfer_end_flag;
+    uint8_t period_start_valid;
+    uint32_t dma_lap_period_count;
+    uint8_t mains_loss_flag;
+    MEASURE_period_queue_statistics_t period_queue_statistics;
     uint32_t sampled_period_count;
     uint8_t period_compute_enable;
     uint32_t tick_led_seconds_count;
@@ -150,6 +266,11 @@ typedef struct {
 #ifdef MPMCM_ANALOG_SIMULATION
     uint8_t random_divider;
 #endif
+#ifdef MPMCM_ANALOG_MEASURE_PROFILING
+    MEASURE_profiling_t profiling;
+    uint64_t profiling_cycles_sum;
+    uint32_t profiling_period_count;
+#endif
 } MEASURE_context_t;
 
 /*** MEASURE global variables ***/
@@ -189,9 +310,36 @@ static const GPIO_pin_t* const MEASURE_GPIO_ACI_DETECT[MEASURE_NUMBER_OF_ACI_CHA
 static volatile MEASURE_sampling_t measure_sampling;
 static volatile MEASURE_data_t measure_data __attribute__((section(".bss_ccmsram")));
 static volatile MEASURE_context_t measure_ctx;
+#ifdef MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS
+static MEASURE_energy_t measure_energy;
+#endif
 
 /*** MEASURE local functions ***/
 
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+/*******************************************************************/
+#define _MEASURE_reset_harmonics_data(data) { \
+    DATA_reset_run(data.voltage_thd_percent); \
+    DATA_reset_run(data.current_thd_percent); \
+    for (rank_idx = 0; rank_idx < MEASURE_NUMBER_OF_HARMONICS; rank_idx++) { \
+        DATA_reset_run(data.voltage_harmonic_percent[rank_idx]); \
+        DATA_reset_run(data.current_harmonic_percent[rank_idx]); \
+    } \
+}
+#endif
+
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+/*******************************************************************/
+#define _MEASURE_copy_harmonics_data(source, destination) { \
+    DATA_copy_run(source.voltage_thd_percent, destination.voltage_thd_percent); \
+    DATA_copy_run(source.current_thd_percent, destination.current_thd_percent); \
+    for (rank_idx = 0; rank_idx < MEASURE_NUMBER_OF_HARMONICS; rank_idx++) { \
+        DATA_copy_run(source.voltage_harmonic_percent[rank_idx], destination.voltage_harmonic_percent[rank_idx]); \
+        DATA_copy_run(source.current_harmonic_percent[rank_idx], destination.current_harmonic_percent[rank_idx]); \
+    } \
+}
+#endif
+
 #ifdef MPMCM_ANALOG_MEASURE_ENABLE
 /*******************************************************************/
 static void _MEASURE_increment_zero_cross_count(void) {
@@ -209,11 +357,14 @@ static void _MEASURE_increment_zero_cross_count(void) {
 
 #ifdef MPMCM_ANALOG_MEASURE_ENABLE
 /*******************************************************************/
-static void _MEASURE_set_dma_transfer_end_flag(void) {
+static void _MEASURE_dma_lap_callback(void) {
     // Local variables.
     MEASURE_status_t measure_status = MEASURE_SUCCESS;
-    // Set local flag.
-    measure_ctx.dma_transfer_end_flag = 1;
+    // Mains is considered lost if no period has been detected during a whole circular buffer lap.
+    if (measure_ctx.dma_lap_period_count == 0) {
+        measure_ctx.mains_loss_flag = 1;
+    }
+    measure_ctx.dma_lap_period_count = 0;
     // Process measure.
     if (measure_ctx.state == MEASURE_STATE_ACTIVE) {
         measure_status = _MEASURE_internal_process();
@@ -226,29 +377,51 @@ static void _MEASURE_set_dma_transfer_end_flag(void) {
 static void _MEASURE_reset(void) {
     // Local variables.
     uint8_t chx_idx = 0;
-    uint32_t idx0 = 0;
-    uint32_t idx1 = 0;
+    uint32_t idx = 0;
+    uint32_t primask = 0;
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+    uint8_t rank_idx = 0;
+#endif
     // Reset indexes.
-    measure_sampling.acv_write_idx = 0;
-    measure_sampling.acv_read_idx = 0;
-    measure_sampling.aci_write_idx = 0;
-    measure_sampling.aci_read_idx = 0;
+    measure_sampling.acv_period_start_idx = 0;
+    measure_sampling.aci_period_start_idx = 0;
+    measure_sampling.acv_period_start_count = 0;
+    measure_sampling.aci_period_start_count = 0;
+    // Flush periods queue and reset its statistics while the zero cross interrupt can not publish a period.
+    CRITICAL_enter(primask);
+    measure_sampling.period_queue_read_count = measure_sampling.period_queue_write_count;
+    measure_ctx.period_queue_statistics.number_of_published_periods = 0;
+    measure_ctx.period_queue_statistics.number_of_dropped_periods = 0;
+    measure_ctx.period_queue_statistics.number_of_overwritten_periods = 0;
+    measure_ctx.period_queue_statistics.max_pending_periods = 0;
+    CRITICAL_exit(primask);
     // Reset flags.
     measure_ctx.processing_enable = 0;
     measure_ctx.zero_cross_count = 0;
-    measure_ctx.dma_transfer_end_flag = 0;
+    measure_ctx.period_start_valid = 0;
+    measure_ctx.dma_lap_period_count = 0;
+    measure_ctx.mains_loss_flag = 0;
     measure_ctx.sampled_period_count = 0;
     measure_ctx.period_compute_enable = 0;
     measure_ctx.tick_led_seconds_count = 0;
 #ifdef MPMCM_ANALOG_SIMULATION
     measure_ctx.random_divider = 1;
+#endif
+#ifdef MPMCM_ANALOG_MEASURE_PROFILING
+    // Reset profiling data.
+    measure_ctx.profiling.period_cycles_last = 0;
+    measure_ctx.profiling.period_cycles_min = 0xFFFFFFFF;
+    measure_ctx.profiling.period_cycles_max = 0;
+    measure_ctx.profiling.period_cycles_mean = 0;
+    measure_ctx.profiling.number_of_periods = 0;
+    measure_ctx.profiling.periods_per_second = 0;
+    measure_ctx.profiling_cycles_sum = 0;
+    measure_ctx.profiling_period_count = 0;
 #endif
     // Reset sampling buffers.
-    for (idx0 = 0; idx0 < MEASURE_PERIOD_ADCX_DMA_BUFFER_DEPTH; idx0++) {
-        for (idx1 = 0; idx1 < MEASURE_PERIOD_ADCX_DMA_BUFFER_SIZE; idx1++) {
-            measure_sampling.acv[idx0].data[idx1] = 0;
-            measure_sampling.aci[idx0].data[idx1] = 0;
-        }
+    for (idx = 0; idx < MEASURE_ADCX_DMA_BUFFER_SIZE; idx++) {
+        measure_sampling.acv[idx] = 0;
+        measure_sampling.aci[idx] = 0;
     }
     // Reset channels data.
     for (chx_idx = 0; chx_idx < MEASURE_NUMBER_OF_ACI_CHANNELS; chx_idx++) {
@@ -258,17 +431,40 @@ static void _MEASURE_reset(void) {
         DATA_reset_accumulated_channel(measure_data.chx_accumulated_data[chx_idx]);
         DATA_reset_run(measure_data.active_energy_mws_sum[chx_idx]);
         DATA_reset_run(measure_data.apparent_energy_mvas_sum[chx_idx]);
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+        _MEASURE_reset_harmonics_data(measure_data.chx_harmonics_rolling_mean[chx_idx]);
+        _MEASURE_reset_harmonics_data(measure_data.chx_harmonics_run_data[chx_idx]);
+#endif
     }
     // Reset frequency data.
     DATA_reset_run(measure_data.acv_frequency_rolling_mean);
     DATA_reset_run(measure_data.acv_frequency_run_data);
     DATA_reset_accumulated(measure_data.acv_frequency_accumulated_data);
     // Reset sampling buffers.
-    for (idx1 = 0; idx1 < MEASURE_PERIOD_TIMX_DMA_BUFFER_SIZE; idx1++) {
-        measure_sampling.acv_frequency_capture[idx1] = 0;
+    for (idx = 0; idx < MEASURE_PERIOD_TIMX_DMA_BUFFER_SIZE; idx++) {
+        measure_sampling.acv_frequency_capture[idx] = 0;
     }
 }
 
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ANALOG_MEASURE_PROFILING))
+/*******************************************************************/
+static void _MEASURE_update_profiling(uint32_t period_cycles) {
+    // Update statistics.
+    measure_ctx.profiling.period_cycles_last = period_cycles;
+    if (period_cycles < measure_ctx.profiling.period_cycles_min) {
+        measure_ctx.profiling.period_cycles_min = period_cycles;
+    }
+    if (period_cycles > measure_ctx.profiling.period_cycles_max) {
+        measure_ctx.profiling.period_cycles_max = period_cycles;
+    }
+    measure_ctx.profiling_cycles_sum += (uint64_t) period_cycles;
+    measure_ctx.profiling.number_of_periods++;
+    measure_ctx.profiling.period_cycles_mean = (uint32_t) (measure_ctx.profiling_cycles_sum / ((uint64_t) measure_ctx.profiling.number_of_periods));
+    // Update periods count of the current second.
+    measure_ctx.profiling_period_count++;
+}
+#endif
+
 #ifdef MPMCM_ANALOG_MEASURE_ENABLE
 /*******************************************************************/
 static MEASURE_status_t _MEASURE_start_analog_transfer(void) {
@@ -332,6 +528,12 @@ static MEASURE_status_t _MEASURE_start(void) {
     uint32_t dma_register_address = 0;
     // Turn TCXO on.
     POWER_enable(POWER_REQUESTER_ID_MEASURE, POWER_DOMAIN_MCU_TCXO, LPTIM_DELAY_MODE_SLEEP);
+#ifdef MPMCM_ANALOG_MEASURE_PROFILING
+    // Enable cycle counter.
+    MEASURE_PROFILING_DEMCR |= MEASURE_PROFILING_DEMCR_TRCENA;
+    MEASURE_PROFILING_DWT_CYCCNT = 0;
+    MEASURE_PROFILING_DWT_CTRL |= MEASURE_PROFILING_DWT_CTRL_CYCCNTENA;
+#endif
     // Switch to PLL (system clock 120MHz, ADC clock 8MHz).
     pll_config.source = RCC_CLOCK_HSE;
     pll_config.hse_mode = RCC_HSE_MODE_BYPASS;
@@ -348,25 +550,28 @@ static MEASURE_status_t _MEASURE_start(void) {
     dma_config.direction = DMA_DIRECTION_PERIPHERAL_TO_MEMORY;
     dma_config.flags.all = 0;
     dma_config.flags.memory_increment = 1;
-    dma_config.memory_address = (uint32_t) &(measure_sampling.acv[measure_sampling.acv_write_idx].data);
+    dma_config.flags.circular_mode = 1;
+    dma_config.memory_address = (uint32_t) &(measure_sampling.acv);
     dma_config.memory_data_size = DMA_DATA_SIZE_16_BITS;
     dma_config.peripheral_address = dma_register_address;
     dma_config.peripheral_data_size = DMA_DATA_SIZE_16_BITS;
-    dma_config.number_of_data = MEASURE_PERIOD_ADCX_DMA_BUFFER_SIZE;
+    dma_config.number_of_data = MEASURE_ADCX_DMA_BUFFER_SIZE;
     dma_config.priority = DMA_PRIORITY_VERY_HIGH;
     dma_config.request_id = DMAMUX_PERIPHERAL_REQUEST_ADC1;
-    dma_config.tc_irq_callback = &_MEASURE_set_dma_transfer_end_flag;
+    dma_config.tc_irq_callback = &_MEASURE_dma_lap_callback;
     dma_config.nvic_priority = NVIC_PRIORITY_DMA_ACV_SAMPLING;
     dma_status = DMA_init(DMA_INSTANCE_ACV_SAMPLING, DMA_CHANNEL_ACV_SAMPLING, &dma_config);
     DMA_exit_error(MEASURE_ERROR_BASE_DMA_ACV_SAMPLING);
     // Init DMA for slave ADC.
     adc_status = ADC_get_slave_dr_register_address(ADC_INSTANCE_ACX_SAMPLING, &dma_register_address);
     ADC_exit_error(MEASURE_ERROR_BASE_ADC);
-    dma_config.memory_address = (uint32_t) &(measure_sampling.aci[measure_sampling.aci_write_idx].data);
+    dma_config.memory_address = (uint32_t) &(measure_sampling.aci);
     dma_config.peripheral_address = dma_register_address;
-    dma_config.number_of_data = MEASURE_PERIOD_ADCX_DMA_BUFFER_SIZE;
+    dma_config.number_of_data = MEASURE_ADCX_DMA_BUFFER_SIZE;
     dma_config.priority = DMA_PRIORITY_HIGH;
     dma_config.request_id = DMAMUX_PERIPHERAL_REQUEST_ADC2;
+    // Note: mains loss detection is only based on the master ADC DMA.
+    dma_config.tc_irq_callback = NULL;
     dma_config.nvic_priority = NVIC_PRIORITY_DMA_ACI_SAMPLING;
     dma_status = DMA_init(DMA_INSTANCE_ACI_SAMPLING, DMA_CHANNEL_ACI_SAMPLING, &dma_config);
     DMA_exit_error(MEASURE_ERROR_BASE_DMA_ACI_SAMPLING);
@@ -403,10 +608,10 @@ static MEASURE_status_t _MEASURE_start(void) {
     TIM_exit_error(MEASURE_ERROR_BASE_TIM_ACV_FREQUENCY);
     tim_status = TIM_STD_init(TIM_INSTANCE_ADC_TRIGGER, NVIC_PRIORITY_ADC_TRIGGER);
     TIM_exit_error(MEASURE_ERROR_BASE_TIM_ADC_TRIGGER);
-    // Re-init LED to update clock frequency.
+    // Re-init LED to update clock frequency (no dimming process callback on MPMCM).
     led_status = LED_de_init();
     LED_exit_error(MEASURE_ERROR_BASE_LED);
-    led_status = LED_init();
+    led_status = LED_init(NULL);
     LED_exit_error(MEASURE_ERROR_BASE_LED);
     // Start frequency measurement timer.
     tim_status = TIM_IC_start_channel(TIM_INSTANCE_ACV_FREQUENCY, TIM_CHANNEL_ACV_FREQUENCY, MEASURE_ACV_FREQUENCY_SAMPLING_HZ, TIM_CAPTURE_PRESCALER_2);
@@ -463,10 +668,10 @@ static void _MEASURE_stop(void) {
     RCC_stack_error(ERROR_BASE_MEASURE + MEASURE_ERROR_BASE_RCC);
     // Turn TCXO off.
     POWER_disable(POWER_REQUESTER_ID_MEASURE, POWER_DOMAIN_MCU_TCXO);
-    // Re-init LED to update clock frequency.
+    // Re-init LED to update clock frequency (no dimming process callback on MPMCM).
     led_status = LED_de_init();
     LED_stack_error(ERROR_BASE_MEASURE + MEASURE_ERROR_BASE_LED);
-    led_status = LED_init();
+    led_status = LED_init(NULL);
     LED_stack_error(ERROR_BASE_MEASURE + MEASURE_ERROR_BASE_LED);
 }
 #endif
@@ -490,28 +695,162 @@ static void _MEASURE_power_off(void) {
 
 #ifdef MPMCM_ANALOG_MEASURE_ENABLE
 /*******************************************************************/
-static MEASURE_status_t _MEASURE_switch_dma_buffer(void) {
+static MEASURE_status_t _MEASURE_set_period_boundary(void) {
     // Local variables.
     MEASURE_status_t status = MEASURE_SUCCESS;
     DMA_status_t dma_status = DMA_SUCCESS;
-    // Stop ADC and DMA.
-    status = _MEASURE_stop_analog_transfer();
-    if (status != MEASURE_SUCCESS) goto errors;
-    // Retrieve number of transfered data.
-    dma_status = DMA_get_number_of_transfered_data(DMA_INSTANCE_ACV_SAMPLING, DMA_CHANNEL_ACV_SAMPLING, (uint16_t*) &(measure_sampling.acv[measure_sampling.acv_write_idx].size));
-    DMA_stack_error(ERROR_BASE_MEASURE + MEASURE_ERROR_BASE_DMA_ACV_SAMPLING);
-    dma_status = DMA_get_number_of_transfered_data(DMA_INSTANCE_ACI_SAMPLING, DMA_CHANNEL_ACI_SAMPLING, (uint16_t*) &(measure_sampling.aci[measure_sampling.aci_write_idx].size));
-    DMA_stack_error(ERROR_BASE_MEASURE + MEASURE_ERROR_BASE_DMA_ACI_SAMPLING);
-    // Update write indexes.
-    measure_sampling.acv_write_idx = ((measure_sampling.acv_write_idx + 1) % MEASURE_PERIOD_ADCX_DMA_BUFFER_DEPTH);
-    measure_sampling.aci_write_idx = ((measure_sampling.aci_write_idx + 1) % MEASURE_PERIOD_ADCX_DMA_BUFFER_DEPTH);
-    // Set new address.
-    dma_status = DMA_set_memory_address(DMA_INSTANCE_ACV_SAMPLING, DMA_CHANNEL_ACV_SAMPLING, (uint32_t) &(measure_sampling.acv[measure_sampling.acv_write_idx].data), MEASURE_PERIOD_ADCX_DMA_BUFFER_SIZE);
-    DMA_stack_error(ERROR_BASE_MEASURE + MEASURE_ERROR_BASE_DMA_ACV_SAMPLING);
-    dma_status = DMA_set_memory_address(DMA_INSTANCE_ACI_SAMPLING, DMA_CHANNEL_ACI_SAMPLING, (uint32_t) &(measure_sampling.aci[measure_sampling.aci_write_idx].data), MEASURE_PERIOD_ADCX_DMA_BUFFER_SIZE);
-    DMA_stack_error(ERROR_BASE_MEASURE + MEASURE_ERROR_BASE_DMA_ACI_SAMPLING);
-    // Restart DMA.
-    status = _MEASURE_start_analog_transfer();
+    volatile MEASURE_period_t* period = NULL;
+    uint32_t pending_periods = 0;
+    uint16_t acv_idx = 0;
+    uint16_t aci_idx = 0;
+    uint16_t acv_size = 0;
+    uint16_t aci_size = 0;
+    // Read current DMA write indexes (acquisition is never stopped).
+    dma_status = DMA_get_number_of_transfered_data(DMA_INSTANCE_ACV_SAMPLING, DMA_CHANNEL_ACV_SAMPLING, &acv_idx);
+    DMA_exit_error(MEASURE_ERROR_BASE_DMA_ACV_SAMPLING);
+    dma_status = DMA_get_number_of_transfered_data(DMA_INSTANCE_ACI_SAMPLING, DMA_CHANNEL_ACI_SAMPLING, &aci_idx);
+    DMA_exit_error(MEASURE_ERROR_BASE_DMA_ACI_SAMPLING);
+    // Align indexes on the first channel of the ADC sequence.
+    acv_idx = (uint16_t) ((acv_idx % MEASURE_ADCX_DMA_BUFFER_SIZE) - (acv_idx % MEASURE_NUMBER_OF_ACI_CHANNELS));
+    aci_idx = (uint16_t) ((aci_idx % MEASURE_ADCX_DMA_BUFFER_SIZE) - (aci_idx % MEASURE_NUMBER_OF_ACI_CHANNELS));
+    // Publish last period from the previous boundary.
+    if (measure_ctx.period_start_valid != 0) {
+        // Compute period size.
+        acv_size = (uint16_t) ((acv_idx + MEASURE_ADCX_DMA_BUFFER_SIZE - measure_sampling.acv_period_start_idx) % MEASURE_ADCX_DMA_BUFFER_SIZE);
+        aci_size = (uint16_t) ((aci_idx + MEASURE_ADCX_DMA_BUFFER_SIZE - measure_sampling.aci_period_start_idx) % MEASURE_ADCX_DMA_BUFFER_SIZE);
+        measure_ctx.dma_lap_period_count++;
+        measure_ctx.period_queue_statistics.number_of_published_periods++;
+        // Check queue space.
+        pending_periods = (measure_sampling.period_queue_write_count - measure_sampling.period_queue_read_count);
+        if (pending_periods >= MEASURE_PERIOD_QUEUE_SIZE) {
+            // Period is lost.
+            measure_ctx.period_queue_statistics.number_of_dropped_periods++;
+        }
+        else {
+            // Fill descriptor.
+            period = &(measure_sampling.period_queue[measure_sampling.period_queue_write_count % MEASURE_PERIOD_QUEUE_SIZE]);
+            period->acv_start_idx = measure_sampling.acv_period_start_idx;
+            period->acv_size = acv_size;
+            period->acv_start_count = measure_sampling.acv_period_start_count;
+            period->aci_start_idx = measure_sampling.aci_period_start_idx;
+            period->aci_size = aci_size;
+            period->aci_start_count = measure_sampling.aci_period_start_count;
+            // Make the descriptor visible to the consumer only once it is complete.
+            measure_sampling.period_queue_write_count++;
+            pending_periods++;
+            SCHEDULER_post_event(SCHEDULER_TASK_NODE);
+            // Update statistics.
+            if (pending_periods > measure_ctx.period_queue_statistics.max_pending_periods) {
+                measure_ctx.period_queue_statistics.max_pending_periods = pending_periods;
+            }
+        }
+    }
+    // Next period starts at the current indexes.
+    measure_sampling.acv_period_start_idx = acv_idx;
+    measure_sampling.aci_period_start_idx = aci_idx;
+    measure_sampling.acv_period_start_count += acv_size;
+    measure_sampling.aci_period_start_count += aci_size;
+    measure_ctx.period_start_valid = 1;
+errors:
+    return status;
+}
+#endif
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ANALOG_MEASURE_HARMONICS))
+/*******************************************************************/
+static inline void _MEASURE_goertzel_add_sample(MEASURE_goertzel_t* goertzel, const float32_t* coefficient, float32_t sample) {
+    // Local variables.
+    float32_t s0 = 0.0;
+    uint8_t rank_idx = 0;
+    // Update the resonator of each harmonic.
+    for (rank_idx = 0; rank_idx < MEASURE_HARMONICS_RANK_MAX; rank_idx++) {
+        s0 = sample + (coefficient[rank_idx] * (goertzel->s1[rank_idx])) - (goertzel->s2[rank_idx]);
+        goertzel->s2[rank_idx] = goertzel->s1[rank_idx];
+        goertzel->s1[rank_idx] = s0;
+    }
+}
+#endif
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ANALOG_MEASURE_HARMONICS))
+/*******************************************************************/
+static void _MEASURE_goertzel_compute(MEASURE_goertzel_t* goertzel, const float32_t* coefficient, float32_t* harmonic_percent, float32_t* thd_percent) {
+    // Local variables.
+    float32_t power[MEASURE_HARMONICS_RANK_MAX];
+    float32_t ratio = 0.0;
+    float32_t ratio_sum = 0.0;
+    float32_t temp_f32 = 0.0;
+    uint8_t rank_idx = 0;
+    // Compute the squared magnitude of each harmonic.
+    for (rank_idx = 0; rank_idx < MEASURE_HARMONICS_RANK_MAX; rank_idx++) {
+        power[rank_idx] = ((goertzel->s1[rank_idx]) * (goertzel->s1[rank_idx])) + ((goertzel->s2[rank_idx]) * (goertzel->s2[rank_idx])) - (coefficient[rank_idx] * (goertzel->s1[rank_idx]) * (goertzel->s2[rank_idx]));
+        // Clamp rounding errors.
+        if (power[rank_idx] < 0.0) {
+            power[rank_idx] = 0.0;
+        }
+    }
+    // Harmonics levels are relative to the fundamental.
+    for (rank_idx = 1; rank_idx < MEASURE_HARMONICS_RANK_MAX; rank_idx++) {
+        ratio = (power[0] > 0.0) ? (power[rank_idx] / power[0]) : 0.0;
+        ratio_sum += ratio;
+        arm_sqrt_f32(ratio, &temp_f32);
+        harmonic_percent[rank_idx - 1] = (MEASURE_HARMONICS_PERCENT_MULTIPLIER * temp_f32);
+    }
+    // Total harmonic distortion up to the last computed rank.
+    arm_sqrt_f32(ratio_sum, &temp_f32);
+    (*thd_percent) = (MEASURE_HARMONICS_PERCENT_MULTIPLIER * temp_f32);
+}
+#endif
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ANALOG_MEASURE_HARMONICS))
+/*******************************************************************/
+static void _MEASURE_compute_harmonics(uint8_t chx_idx, MEASURE_goertzel_t* acv_goertzel, MEASURE_goertzel_t* aci_goertzel, const float32_t* coefficient) {
+    // Local variables.
+    float32_t voltage_harmonic_percent[MEASURE_NUMBER_OF_HARMONICS];
+    float32_t current_harmonic_percent[MEASURE_NUMBER_OF_HARMONICS];
+    float32_t voltage_thd_percent = 0.0;
+    float32_t current_thd_percent = 0.0;
+    uint8_t rank_idx = 0;
+    // Compute harmonics levels.
+    _MEASURE_goertzel_compute(acv_goertzel, coefficient, voltage_harmonic_percent, &voltage_thd_percent);
+    _MEASURE_goertzel_compute(aci_goertzel, coefficient, current_harmonic_percent, &current_thd_percent);
+    // Update rolling means.
+    _MEASURE_add_rolling_sample(measure_data.chx_harmonics_rolling_mean[chx_idx].voltage_thd_percent, voltage_thd_percent);
+    _MEASURE_add_rolling_sample(measure_data.chx_harmonics_rolling_mean[chx_idx].current_thd_percent, current_thd_percent);
+    for (rank_idx = 0; rank_idx < MEASURE_NUMBER_OF_HARMONICS; rank_idx++) {
+        _MEASURE_add_rolling_sample(measure_data.chx_harmonics_rolling_mean[chx_idx].voltage_harmonic_percent[rank_idx], voltage_harmonic_percent[rank_idx]);
+        _MEASURE_add_rolling_sample(measure_data.chx_harmonics_rolling_mean[chx_idx].current_harmonic_percent[rank_idx], current_harmonic_percent[rank_idx]);
+    }
+}
+#endif
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && !(defined MPMCM_ANALOG_SIMULATION))
+/*******************************************************************/
+static MEASURE_status_t _MEASURE_check_period_samples(MEASURE_period_t* period, uint8_t* samples_valid) {
+    // Local variables.
+    MEASURE_status_t status = MEASURE_SUCCESS;
+    DMA_status_t dma_status = DMA_SUCCESS;
+    uint16_t acv_idx = 0;
+    uint16_t aci_idx = 0;
+    uint32_t acv_write_count = 0;
+    uint32_t aci_write_count = 0;
+    uint32_t primask = 0;
+    // Reset flag.
+    (*samples_valid) = 0;
+    // Read DMA write indexes and the current period start with interrupts masked since a boundary can be set concurrently.
+    // Note: the DMA can not complete a whole lap since the last boundary, otherwise mains would have been considered lost.
+    CRITICAL_enter(primask);
+    dma_status = DMA_get_number_of_transfered_data(DMA_INSTANCE_ACV_SAMPLING, DMA_CHANNEL_ACV_SAMPLING, &acv_idx);
+    if (dma_status == DMA_SUCCESS) {
+        dma_status = DMA_get_number_of_transfered_data(DMA_INSTANCE_ACI_SAMPLING, DMA_CHANNEL_ACI_SAMPLING, &aci_idx);
+    }
+    acv_write_count = measure_sampling.acv_period_start_count + (((acv_idx % MEASURE_ADCX_DMA_BUFFER_SIZE) + MEASURE_ADCX_DMA_BUFFER_SIZE - measure_sampling.acv_period_start_idx) % MEASURE_ADCX_DMA_BUFFER_SIZE);
+    aci_write_count = measure_sampling.aci_period_start_count + (((aci_idx % MEASURE_ADCX_DMA_BUFFER_SIZE) + MEASURE_ADCX_DMA_BUFFER_SIZE - measure_sampling.aci_period_start_idx) % MEASURE_ADCX_DMA_BUFFER_SIZE);
+    CRITICAL_exit(primask);
+    DMA_exit_error(MEASURE_ERROR_BASE_DMA_ACV_SAMPLING);
+    // Samples are valid as long as the DMA has not written a whole circular buffer since the period start.
+    if (((acv_write_count - (period->acv_start_count)) <= MEASURE_ADCX_DMA_BUFFER_SIZE) && ((aci_write_count - (period->aci_start_count)) <= MEASURE_ADCX_DMA_BUFFER_SIZE)) {
+        (*samples_valid) = 1;
+    }
 errors:
     return status;
 }
@@ -519,23 +858,56 @@ errors:
 
 #ifdef MPMCM_ANALOG_MEASURE_ENABLE
 /*******************************************************************/
-static void _MEASURE_compute_period_data(void) {
+static void _MEASURE_compute_period_data(MEASURE_period_t* period) {
     // Local variables.
     uint32_t acv_buffer_size = 0;
     uint32_t aci_buffer_size = 0;
+#ifndef MPMCM_ANALOG_SIMULATION
+    MEASURE_status_t measure_status = MEASURE_SUCCESS;
+    uint32_t acv_sample_idx = 0;
+    uint32_t aci_sample_idx = 0;
+    uint8_t samples_valid = 0;
+#endif
+#ifdef MPMCM_ANALOG_MEASURE_CMSIS_DSP
     float32_t mean_voltage_f32 = 0.0;
     float32_t mean_current_f32 = 0.0;
-    float64_t active_power_mw = 0.0;
-    float64_t rms_voltage_mv = 0.0;
-    float64_t rms_current_ma = 0.0;
-    float64_t apparent_power_mva = 0.0;
-    float64_t power_factor = 0.0;
+#else
+    int32_t acv_sample = 0;
+    int32_t aci_sample = 0;
+    int32_t acv_sum = 0;
+    int32_t aci_sum = 0;
+    int64_t acv_square_sum = 0;
+    int64_t aci_square_sum = 0;
+    int64_t acp_sum = 0;
+    int64_t temp_s64 = 0;
+    float32_t number_of_samples_square = 0.0;
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+    float32_t mean_voltage_f32 = 0.0;
+    float32_t mean_current_f32 = 0.0;
+#endif
+#endif
+    MEASURE_float_t active_power_mw = MEASURE_FLOAT_ZERO;
+    MEASURE_float_t rms_voltage_mv = MEASURE_FLOAT_ZERO;
+    MEASURE_float_t rms_current_ma = MEASURE_FLOAT_ZERO;
+    MEASURE_float_t apparent_power_mva = MEASURE_FLOAT_ZERO;
+    MEASURE_float_t power_factor = MEASURE_FLOAT_ZERO;
     uint32_t acv_frequency_capture_delta = 0;
-    float64_t frequency_mhz = 0.0;
-    float64_t temp_f64 = 0.0;
+    MEASURE_float_t frequency_mhz = MEASURE_FLOAT_ZERO;
+    MEASURE_float_t temp_float = MEASURE_FLOAT_ZERO;
     uint8_t chx_idx = 0;
+#ifdef MPMCM_ANALOG_SIMULATION
     uint32_t sample_idx = 0;
+#endif
     uint32_t idx = 0;
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+    MEASURE_goertzel_t acv_goertzel;
+    MEASURE_goertzel_t aci_goertzel;
+    float32_t goertzel_coefficient[MEASURE_HARMONICS_RANK_MAX];
+    uint8_t rank_idx = 0;
+#endif
+#ifdef MPMCM_ANALOG_MEASURE_PROFILING
+    uint32_t profiling_start_cycles = MEASURE_PROFILING_DWT_CYCCNT;
+#endif
     // Check enable flag.
     if (measure_ctx.processing_enable == 0) goto errors;
     // Check compute flag.
@@ -555,8 +927,8 @@ static void _MEASURE_compute_period_data(void) {
     acv_buffer_size = (SIMULATION_BUFFER_SIZE / MEASURE_NUMBER_OF_ACI_CHANNELS);
     aci_buffer_size = (SIMULATION_BUFFER_SIZE / MEASURE_NUMBER_OF_ACI_CHANNELS);
 #else
-    acv_buffer_size = (uint32_t) ((measure_sampling.acv[measure_sampling.acv_read_idx].size) / (MEASURE_NUMBER_OF_ACI_CHANNELS));
-    aci_buffer_size = (uint32_t) ((measure_sampling.aci[measure_sampling.acv_read_idx].size) / (MEASURE_NUMBER_OF_ACI_CHANNELS));
+    acv_buffer_size = (uint32_t) ((period->acv_size) / (MEASURE_NUMBER_OF_ACI_CHANNELS));
+    aci_buffer_size = (uint32_t) ((period->aci_size) / (MEASURE_NUMBER_OF_ACI_CHANNELS));
 #endif
     // Take the minimum size between voltage and current.
     measure_data.period_acxx_buffer_size = (acv_buffer_size < aci_buffer_size) ? acv_buffer_size : aci_buffer_size;
@@ -564,20 +936,50 @@ static void _MEASURE_compute_period_data(void) {
     if ((measure_data.period_acxx_buffer_size < measure_data.period_acxx_buffer_size_low_limit) || (measure_data.period_acxx_buffer_size > measure_data.period_acxx_buffer_size_high_limit)) {
         goto errors;
     }
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+    // Goertzel coefficients: the period holds one mains cycle, so that harmonic of rank k is exactly the bin k of the period DFT.
+    for (rank_idx = 0; rank_idx < MEASURE_HARMONICS_RANK_MAX; rank_idx++) {
+        goertzel_coefficient[rank_idx] = 2.0f * arm_cos_f32((MEASURE_HARMONICS_TWO_PI * ((float32_t) (rank_idx + 1))) / ((float32_t) measure_data.period_acxx_buffer_size));
+    }
+#endif
     // Processing each channel.
     for (chx_idx = 0; chx_idx < MEASURE_NUMBER_OF_ACI_CHANNELS; chx_idx++) {
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+        // Reset resonators.
+        for (rank_idx = 0; rank_idx < MEASURE_HARMONICS_RANK_MAX; rank_idx++) {
+            acv_goertzel.s1[rank_idx] = 0.0;
+            acv_goertzel.s2[rank_idx] = 0.0;
+            aci_goertzel.s1[rank_idx] = 0.0;
+            aci_goertzel.s2[rank_idx] = 0.0;
+        }
+#endif
+#ifndef MPMCM_ANALOG_SIMULATION
+        // First samples of the channel in circular buffers.
+        acv_sample_idx = ((period->acv_start_idx) + chx_idx);
+        aci_sample_idx = ((period->aci_start_idx) + chx_idx);
+        // Update current probe detect flag.
+        measure_ctx.probe_detect_flag[chx_idx] = GPIO_read(MEASURE_GPIO_ACI_DETECT[chx_idx]);
+#endif
+#ifdef MPMCM_ANALOG_MEASURE_CMSIS_DSP
         // Compute channel buffer.
         for (idx = 0; idx < (measure_data.period_acxx_buffer_size); idx++) {
-            // Copy samples by channel and convert to Q31 type.
-            sample_idx = (MEASURE_NUMBER_OF_ACI_CHANNELS * idx) + chx_idx;
+            // Copy samples by channel and convert to float type.
 #ifdef MPMCM_ANALOG_SIMULATION
+            sample_idx = (MEASURE_NUMBER_OF_ACI_CHANNELS * idx) + chx_idx;
             measure_data.period_acvx_buffer_f32[idx] = (float32_t) (SIMULATION_ACV_BUFFER[sample_idx]);
             measure_data.period_acix_buffer_f32[idx] = (float32_t) (SIMULATION_ACI_BUFFER[sample_idx] / measure_ctx.random_divider);
 #else
-            measure_data.period_acvx_buffer_f32[idx] = (float32_t) (measure_sampling.acv[measure_sampling.acv_read_idx].data[sample_idx]);
-            measure_data.period_acix_buffer_f32[idx] = (float32_t) (measure_sampling.aci[measure_sampling.aci_read_idx].data[sample_idx]);
-            // Update current probe detect flag.
-            measure_ctx.probe_detect_flag[chx_idx] = GPIO_read(MEASURE_GPIO_ACI_DETECT[chx_idx]);
+            measure_data.period_acvx_buffer_f32[idx] = (float32_t) (measure_sampling.acv[acv_sample_idx]);
+            measure_data.period_acix_buffer_f32[idx] = (float32_t) (measure_sampling.aci[aci_sample_idx]);
+            // Go to next sample with circular buffers rollover management.
+            acv_sample_idx += MEASURE_NUMBER_OF_ACI_CHANNELS;
+            if (acv_sample_idx >= MEASURE_ADCX_DMA_BUFFER_SIZE) {
+                acv_sample_idx -= MEASURE_ADCX_DMA_BUFFER_SIZE;
+            }
+            aci_sample_idx += MEASURE_NUMBER_OF_ACI_CHANNELS;
+            if (aci_sample_idx >= MEASURE_ADCX_DMA_BUFFER_SIZE) {
+                aci_sample_idx -= MEASURE_ADCX_DMA_BUFFER_SIZE;
+            }
             // Force current to 0 if sensor is not connected.
             if (measure_ctx.probe_detect_flag[chx_idx] == 0) {
                 measure_data.period_acix_buffer_f32[idx] = 0.0;
@@ -591,40 +993,138 @@ static void _MEASURE_compute_period_data(void) {
         for (idx = 0; idx < (measure_data.period_acxx_buffer_size); idx++) {
             measure_data.period_acvx_buffer_f32[idx] -= mean_voltage_f32;
             measure_data.period_acix_buffer_f32[idx] -= mean_current_f32;
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+            _MEASURE_goertzel_add_sample(&acv_goertzel, goertzel_coefficient, measure_data.period_acvx_buffer_f32[idx]);
+            _MEASURE_goertzel_add_sample(&aci_goertzel, goertzel_coefficient, measure_data.period_acix_buffer_f32[idx]);
+#endif
         }
         // Instantaneous power.
         arm_mult_f32((float32_t*) measure_data.period_acvx_buffer_f32, (float32_t*) measure_data.period_acix_buffer_f32, (float32_t*) measure_data.period_acpx_buffer_f32, measure_data.period_acxx_buffer_size);
         // Active power.
         arm_mean_f32((float32_t*) measure_data.period_acpx_buffer_f32, measure_data.period_acxx_buffer_size, (float32_t*) &(measure_data.period_active_power_f32));
-        temp_f64 = (float64_t) measure_data.period_active_power_f32;
-        temp_f64 *= measure_data.acp_factor_num[chx_idx];
-        active_power_mw = (temp_f64 / measure_data.acp_factor_den);
-        // RMS voltage.
+        // RMS voltage and current.
         arm_rms_f32((float32_t*) measure_data.period_acvx_buffer_f32, measure_data.period_acxx_buffer_size, (float32_t*) &(measure_data.period_rms_voltage_f32));
-        temp_f64 = measure_data.acv_factor_num * ((float64_t) measure_data.period_rms_voltage_f32);
-        rms_voltage_mv = (temp_f64 / measure_data.acv_factor_den);
-        // RMS current.
         arm_rms_f32((float32_t*) measure_data.period_acix_buffer_f32, measure_data.period_acxx_buffer_size, (float32_t*) &(measure_data.period_rms_current_f32));
-        temp_f64 = measure_data.aci_factor_num[chx_idx] * ((float64_t) measure_data.period_rms_current_f32);
-        rms_current_ma = (temp_f64 / measure_data.aci_factor_den);
+#else
+        // Reset accumulators.
+        acv_sum = 0;
+        aci_sum = 0;
+        acv_square_sum = 0;
+        aci_square_sum = 0;
+        acp_sum = 0;
+        // Single pass over the channel samples.
+        for (idx = 0; idx < (measure_data.period_acxx_buffer_size); idx++) {
+#ifdef MPMCM_ANALOG_SIMULATION
+            sample_idx = (MEASURE_NUMBER_OF_ACI_CHANNELS * idx) + chx_idx;
+            acv_sample = (int32_t) (SIMULATION_ACV_BUFFER[sample_idx]);
+            aci_sample = (int32_t) (SIMULATION_ACI_BUFFER[sample_idx] / measure_ctx.random_divider);
+#else
+            acv_sample = (int32_t) (measure_sampling.acv[acv_sample_idx]);
+            // Force current to 0 if sensor is not connected.
+            aci_sample = (measure_ctx.probe_detect_flag[chx_idx] == 0) ? 0 : (int32_t) (measure_sampling.aci[aci_sample_idx]);
+            // Go to next sample with circular buffers rollover management.
+            acv_sample_idx += MEASURE_NUMBER_OF_ACI_CHANNELS;
+            if (acv_sample_idx >= MEASURE_ADCX_DMA_BUFFER_SIZE) {
+                acv_sample_idx -= MEASURE_ADCX_DMA_BUFFER_SIZE;
+            }
+            aci_sample_idx += MEASURE_NUMBER_OF_ACI_CHANNELS;
+            if (aci_sample_idx >= MEASURE_ADCX_DMA_BUFFER_SIZE) {
+                aci_sample_idx -= MEASURE_ADCX_DMA_BUFFER_SIZE;
+            }
+#endif
+            // Update accumulators.
+            acv_sum += acv_sample;
+            aci_sum += aci_sample;
+            acv_square_sum += (int64_t) (acv_sample * acv_sample);
+            aci_square_sum += (int64_t) (aci_sample * aci_sample);
+            acp_sum += (int64_t) (acv_sample * aci_sample);
+        }
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+        // Mean voltage and current.
+        mean_voltage_f32 = ((float32_t) acv_sum) / ((float32_t) measure_data.period_acxx_buffer_size);
+        mean_current_f32 = ((float32_t) aci_sum) / ((float32_t) measure_data.period_acxx_buffer_size);
+#ifndef MPMCM_ANALOG_SIMULATION
+        // Go back to the first samples of the channel.
+        acv_sample_idx = ((period->acv_start_idx) + chx_idx);
+        aci_sample_idx = ((period->aci_start_idx) + chx_idx);
+#endif
+        // Second pass to feed the resonators with DC-free samples.
+        for (idx = 0; idx < (measure_data.period_acxx_buffer_size); idx++) {
+#ifdef MPMCM_ANALOG_SIMULATION
+            sample_idx = (MEASURE_NUMBER_OF_ACI_CHANNELS * idx) + chx_idx;
+            acv_sample = (int32_t) (SIMULATION_ACV_BUFFER[sample_idx]);
+            aci_sample = (int32_t) (SIMULATION_ACI_BUFFER[sample_idx] / measure_ctx.random_divider);
+#else
+            acv_sample = (int32_t) (measure_sampling.acv[acv_sample_idx]);
+            aci_sample = (measure_ctx.probe_detect_flag[chx_idx] == 0) ? 0 : (int32_t) (measure_sampling.aci[aci_sample_idx]);
+            acv_sample_idx += MEASURE_NUMBER_OF_ACI_CHANNELS;
+            if (acv_sample_idx >= MEASURE_ADCX_DMA_BUFFER_SIZE) {
+                acv_sample_idx -= MEASURE_ADCX_DMA_BUFFER_SIZE;
+            }
+            aci_sample_idx += MEASURE_NUMBER_OF_ACI_CHANNELS;
+            if (aci_sample_idx >= MEASURE_ADCX_DMA_BUFFER_SIZE) {
+                aci_sample_idx -= MEASURE_ADCX_DMA_BUFFER_SIZE;
+            }
+#endif
+            _MEASURE_goertzel_add_sample(&acv_goertzel, goertzel_coefficient, (((float32_t) acv_sample) - mean_voltage_f32));
+            _MEASURE_goertzel_add_sample(&aci_goertzel, goertzel_coefficient, (((float32_t) aci_sample) - mean_current_f32));
+        }
+#endif
+        // DC removal is performed on the sums with exact integer arithmetic:
+        // N^2 * mean((x - mean(x)) * (y - mean(y))) = (N * sum(x * y)) - (sum(x) * sum(y)).
+        // Note: the result matches the CMSIS-DSP path with a relative error lower than 1e-5 (float32 accumulation errors of the latter).
+        number_of_samples_square = (float32_t) (measure_data.period_acxx_buffer_size * measure_data.period_acxx_buffer_size);
+        // Active power.
+        temp_s64 = (((int64_t) measure_data.period_acxx_buffer_size) * acp_sum) - (((int64_t) acv_sum) * ((int64_t) aci_sum));
+        measure_data.period_active_power_f32 = ((float32_t) temp_s64) / number_of_samples_square;
+        // RMS voltage.
+        temp_s64 = (((int64_t) measure_data.period_acxx_buffer_size) * acv_square_sum) - (((int64_t) acv_sum) * ((int64_t) acv_sum));
+        arm_sqrt_f32((((float32_t) temp_s64) / number_of_samples_square), (float32_t*) &(measure_data.period_rms_voltage_f32));
+        // RMS current.
+        temp_s64 = (((int64_t) measure_data.period_acxx_buffer_size) * aci_square_sum) - (((int64_t) aci_sum) * ((int64_t) aci_sum));
+        arm_sqrt_f32((((float32_t) temp_s64) / number_of_samples_square), (float32_t*) &(measure_data.period_rms_current_f32));
+#endif
+#ifndef MPMCM_ANALOG_SIMULATION
+        // Discard the period if the DMA has overwritten its samples while they were read.
+        // Note: the channels already computed are kept since their samples were read before.
+        measure_status = _MEASURE_check_period_samples(period, &samples_valid);
+        MEASURE_stack_error(ERROR_BASE_MEASURE);
+        if (samples_valid == 0) {
+            measure_ctx.period_queue_statistics.number_of_overwritten_periods++;
+            goto errors;
+        }
+#endif
+        // Convert active power.
+        temp_float = (MEASURE_float_t) measure_data.period_active_power_f32;
+        temp_float *= measure_data.acp_factor_num[chx_idx];
+        active_power_mw = (temp_float / measure_data.acp_factor_den);
+        // Convert RMS voltage.
+        temp_float = measure_data.acv_factor_num * ((MEASURE_float_t) measure_data.period_rms_voltage_f32);
+        rms_voltage_mv = (temp_float / measure_data.acv_factor_den);
+        // Convert RMS current.
+        temp_float = measure_data.aci_factor_num[chx_idx] * ((MEASURE_float_t) measure_data.period_rms_current_f32);
+        rms_current_ma = (temp_float / measure_data.aci_factor_den);
         // Apparent power.
-        temp_f64 = (rms_voltage_mv * rms_current_ma);
-        apparent_power_mva = ((temp_f64) / ((float64_t) 1000.0));
-        if (((active_power_mw > 0.0) && (apparent_power_mva < 0.0)) || ((active_power_mw < 0.0) && (apparent_power_mva > 0.0))) {
-            apparent_power_mva *= (-1.0);
+        temp_float = (rms_voltage_mv * rms_current_ma);
+        apparent_power_mva = (temp_float / MEASURE_FLOAT_MILLI_DIVIDER);
+        if (((active_power_mw > MEASURE_FLOAT_ZERO) && (apparent_power_mva < MEASURE_FLOAT_ZERO)) || ((active_power_mw < MEASURE_FLOAT_ZERO) && (apparent_power_mva > MEASURE_FLOAT_ZERO))) {
+            apparent_power_mva *= MEASURE_FLOAT_MINUS_ONE;
         }
         // Power factor.
-        temp_f64 = (active_power_mw * ((float64_t) MEASURE_POWER_FACTOR_MULTIPLIER));
-        power_factor = (apparent_power_mva != 0.0) ? (temp_f64 / apparent_power_mva) : 0;
-        if (((active_power_mw > 0.0) && (power_factor < 0.0)) || ((active_power_mw < 0.0) && (power_factor > 0.0))) {
-            power_factor *= (-1.0);
+        temp_float = (active_power_mw * ((MEASURE_float_t) MEASURE_POWER_FACTOR_MULTIPLIER));
+        power_factor = (apparent_power_mva != MEASURE_FLOAT_ZERO) ? (temp_float / apparent_power_mva) : MEASURE_FLOAT_ZERO;
+        if (((active_power_mw > MEASURE_FLOAT_ZERO) && (power_factor < MEASURE_FLOAT_ZERO)) || ((active_power_mw < MEASURE_FLOAT_ZERO) && (power_factor > MEASURE_FLOAT_ZERO))) {
+            power_factor *= MEASURE_FLOAT_MINUS_ONE;
         }
         // Update accumulated data.
-        DATA_add_run_channel_sample(measure_data.chx_rolling_mean[chx_idx], active_power_mw, active_power_mw);
-        DATA_add_run_channel_sample(measure_data.chx_rolling_mean[chx_idx], rms_voltage_mv, rms_voltage_mv);
-        DATA_add_run_channel_sample(measure_data.chx_rolling_mean[chx_idx], rms_current_ma, rms_current_ma);
-        DATA_add_run_channel_sample(measure_data.chx_rolling_mean[chx_idx], apparent_power_mva, apparent_power_mva);
-        DATA_add_run_channel_sample(measure_data.chx_rolling_mean[chx_idx], power_factor, power_factor);
+        _MEASURE_add_rolling_channel_sample(measure_data.chx_rolling_mean[chx_idx], active_power_mw, active_power_mw);
+        _MEASURE_add_rolling_channel_sample(measure_data.chx_rolling_mean[chx_idx], rms_voltage_mv, rms_voltage_mv);
+        _MEASURE_add_rolling_channel_sample(measure_data.chx_rolling_mean[chx_idx], rms_current_ma, rms_current_ma);
+        _MEASURE_add_rolling_channel_sample(measure_data.chx_rolling_mean[chx_idx], apparent_power_mva, apparent_power_mva);
+        _MEASURE_add_rolling_channel_sample(measure_data.chx_rolling_mean[chx_idx], power_factor, power_factor);
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+        _MEASURE_compute_harmonics(chx_idx, &acv_goertzel, &aci_goertzel, goertzel_coefficient);
+#endif
     }
     // Compute mains frequency.
     for (idx = 0; idx < MEASURE_PERIOD_TIMX_DMA_BUFFER_SIZE; idx++) {
@@ -639,14 +1139,16 @@ static void _MEASURE_compute_period_data(void) {
     // Check index.
     if (idx < MEASURE_PERIOD_TIMX_DMA_BUFFER_SIZE) {
         // Compute mains frequency.
-        frequency_mhz = (((float64_t) (MEASURE_ACV_FREQUENCY_SAMPLING_HZ * 1000)) / ((float64_t) acv_frequency_capture_delta));
+        frequency_mhz = (((MEASURE_float_t) (MEASURE_ACV_FREQUENCY_SAMPLING_HZ * 1000)) / ((MEASURE_float_t) acv_frequency_capture_delta));
         // Update accumulated data.
-        DATA_add_run_sample(measure_data.acv_frequency_rolling_mean, frequency_mhz);
+        _MEASURE_add_rolling_sample(measure_data.acv_frequency_rolling_mean, frequency_mhz);
     }
+#ifdef MPMCM_ANALOG_MEASURE_PROFILING
+    // Update profiling data (counter rollover is handled by unsigned subtraction).
+    _MEASURE_update_profiling(MEASURE_PROFILING_DWT_CYCCNT - profiling_start_cycles);
+#endif
 errors:
-    // Update read indexes.
-    measure_sampling.acv_read_idx = ((measure_sampling.acv_read_idx + 1) % MEASURE_PERIOD_ADCX_DMA_BUFFER_DEPTH);
-    measure_sampling.aci_read_idx = ((measure_sampling.aci_read_idx + 1) % MEASURE_PERIOD_ADCX_DMA_BUFFER_DEPTH);
+    return;
 }
 #endif
 
@@ -655,11 +1157,18 @@ errors:
 static void _MEASURE_compute_run_data(void) {
     // Local variables.
     uint8_t chx_idx = 0;
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+    uint8_t rank_idx = 0;
+#endif
     // Compute AC channels run data.
     for (chx_idx = 0; chx_idx < MEASURE_NUMBER_OF_ACI_CHANNELS; chx_idx++) {
         // Copy all rolling means and reset.
         DATA_copy_run_channel(measure_data.chx_rolling_mean[chx_idx], measure_data.chx_run_data[chx_idx]);
         DATA_reset_run_channel(measure_data.chx_rolling_mean[chx_idx]);
+#ifdef MPMCM_ANALOG_MEASURE_HARMONICS
+        _MEASURE_copy_harmonics_data(measure_data.chx_harmonics_rolling_mean[chx_idx], measure_data.chx_harmonics_run_data[chx_idx]);
+        _MEASURE_reset_harmonics_data(measure_data.chx_harmonics_rolling_mean[chx_idx]);
+#endif
     }
     // Compute frequency run data and reset.
     DATA_copy_run(measure_data.acv_frequency_rolling_mean, measure_data.acv_frequency_run_data);
@@ -667,6 +1176,122 @@ static void _MEASURE_compute_run_data(void) {
 }
 #endif
 
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS))
+/*******************************************************************/
+static uint32_t _MEASURE_compute_energy_checksum(uint32_t* slot) {
+    // Local variables.
+    uint32_t checksum = MEASURE_ENERGY_NVM_CHECKSUM_SEED;
+    uint8_t idx = 0;
+    // Rotating sum of all slot words.
+    for (idx = 0; idx < MEASURE_ENERGY_NVM_SLOT_CHECKSUM_WORD_INDEX; idx++) {
+        checksum += slot[idx];
+        checksum = ((checksum << 1) | (checksum >> 31));
+    }
+    return checksum;
+}
+#endif
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS))
+/*******************************************************************/
+static MEASURE_status_t _MEASURE_restore_energy_totals(void) {
+    // Local variables.
+    MEASURE_status_t status = MEASURE_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint32_t slot[MEASURE_ENERGY_NVM_SLOT_SIZE_WORDS];
+    uint8_t checkpoint_found = 0;
+    uint8_t slot_idx = 0;
+    uint8_t chx_idx = 0;
+    uint8_t idx = 0;
+    // Reset totals.
+    for (chx_idx = 0; chx_idx < MEASURE_NUMBER_OF_ACI_CHANNELS; chx_idx++) {
+        measure_energy.active_energy_wh_total[chx_idx] = 0;
+        measure_energy.apparent_energy_vah_total[chx_idx] = 0;
+        measure_energy.active_energy_mws_residual[chx_idx] = 0.0;
+        measure_energy.apparent_energy_mvas_residual[chx_idx] = 0.0;
+    }
+    measure_energy.nvm_sequence_number = 0;
+    measure_energy.nvm_slot_index = (MEASURE_ENERGY_NVM_NUMBER_OF_SLOTS - 1);
+    measure_energy.checkpoint_seconds_count = 0;
+    measure_energy.checkpoint_pending = 0;
+    // Search the most recent valid checkpoint.
+    for (slot_idx = 0; slot_idx < MEASURE_ENERGY_NVM_NUMBER_OF_SLOTS; slot_idx++) {
+        // Read slot.
+        for (idx = 0; idx < MEASURE_ENERGY_NVM_SLOT_SIZE_WORDS; idx++) {
+            nvm_status = NVM_read_word((NVM_ADDRESS_ENERGY_CHECKPOINT + (slot_idx * MEASURE_ENERGY_NVM_SLOT_SIZE_WORDS) + idx), &(slot[idx]));
+            NVM_exit_error(MEASURE_ERROR_BASE_NVM);
+        }
+        // Skip erased or partially written slots.
+        if (slot[MEASURE_ENERGY_NVM_SLOT_CHECKSUM_WORD_INDEX] != _MEASURE_compute_energy_checksum(slot)) continue;
+        // Skip older checkpoints.
+        if ((checkpoint_found != 0) && (slot[MEASURE_ENERGY_NVM_SLOT_SEQUENCE_WORD_INDEX] <= measure_energy.nvm_sequence_number)) continue;
+        // Load totals.
+        for (chx_idx = 0; chx_idx < MEASURE_NUMBER_OF_ACI_CHANNELS; chx_idx++) {
+            measure_energy.active_energy_wh_total[chx_idx] = (int32_t) slot[MEASURE_ENERGY_NVM_SLOT_ACTIVE_WORD_INDEX + chx_idx];
+            measure_energy.apparent_energy_vah_total[chx_idx] = (int32_t) slot[MEASURE_ENERGY_NVM_SLOT_APPARENT_WORD_INDEX + chx_idx];
+        }
+        measure_energy.nvm_sequence_number = slot[MEASURE_ENERGY_NVM_SLOT_SEQUENCE_WORD_INDEX];
+        measure_energy.nvm_slot_index = slot_idx;
+        checkpoint_found = 1;
+    }
+errors:
+    return status;
+}
+#endif
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS))
+/*******************************************************************/
+static MEASURE_status_t _MEASURE_store_energy_totals(void) {
+    // Local variables.
+    MEASURE_status_t status = MEASURE_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint32_t slot[MEASURE_ENERGY_NVM_SLOT_SIZE_WORDS];
+    uint8_t slot_idx = ((measure_energy.nvm_slot_index + 1) % MEASURE_ENERGY_NVM_NUMBER_OF_SLOTS);
+    uint8_t chx_idx = 0;
+    uint8_t idx = 0;
+    // Build slot.
+    slot[MEASURE_ENERGY_NVM_SLOT_SEQUENCE_WORD_INDEX] = (measure_energy.nvm_sequence_number + 1);
+    for (chx_idx = 0; chx_idx < MEASURE_NUMBER_OF_ACI_CHANNELS; chx_idx++) {
+        slot[MEASURE_ENERGY_NVM_SLOT_ACTIVE_WORD_INDEX + chx_idx] = (uint32_t) measure_energy.active_energy_wh_total[chx_idx];
+        slot[MEASURE_ENERGY_NVM_SLOT_APPARENT_WORD_INDEX + chx_idx] = (uint32_t) measure_energy.apparent_energy_vah_total[chx_idx];
+    }
+    slot[MEASURE_ENERGY_NVM_SLOT_CHECKSUM_WORD_INDEX] = _MEASURE_compute_energy_checksum(slot);
+    // Write the oldest slot: the checksum is written last so that a reset during the write only invalidates this slot.
+    for (idx = 0; idx < MEASURE_ENERGY_NVM_SLOT_SIZE_WORDS; idx++) {
+        nvm_status = NVM_write_word((NVM_ADDRESS_ENERGY_CHECKPOINT + (slot_idx * MEASURE_ENERGY_NVM_SLOT_SIZE_WORDS) + idx), slot[idx]);
+        NVM_exit_error(MEASURE_ERROR_BASE_NVM);
+    }
+    // Update context once the slot is complete.
+    measure_energy.nvm_sequence_number = slot[MEASURE_ENERGY_NVM_SLOT_SEQUENCE_WORD_INDEX];
+    measure_energy.nvm_slot_index = slot_idx;
+    measure_energy.checkpoint_pending = 0;
+errors:
+    return status;
+}
+#endif
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS))
+/*******************************************************************/
+static void _MEASURE_update_energy_totals(uint8_t chx_idx) {
+    // Local variables.
+    int32_t active_energy_wh = 0;
+    int32_t apparent_energy_vah = 0;
+    // Integrate last second power.
+    measure_energy.active_energy_mws_residual[chx_idx] += measure_data.chx_run_data[chx_idx].active_power_mw.value;
+    measure_energy.apparent_energy_mvas_residual[chx_idx] += measure_data.chx_run_data[chx_idx].apparent_power_mva.value;
+    // Transfer whole Wh and VAh to the totals.
+    active_energy_wh = (int32_t) (measure_energy.active_energy_mws_residual[chx_idx] / MEASURE_ENERGY_MWS_PER_WH);
+    apparent_energy_vah = (int32_t) (measure_energy.apparent_energy_mvas_residual[chx_idx] / MEASURE_ENERGY_MWS_PER_WH);
+    measure_energy.active_energy_wh_total[chx_idx] += active_energy_wh;
+    measure_energy.apparent_energy_vah_total[chx_idx] += apparent_energy_vah;
+    measure_energy.active_energy_mws_residual[chx_idx] -= (((float64_t) active_energy_wh) * MEASURE_ENERGY_MWS_PER_WH);
+    measure_energy.apparent_energy_mvas_residual[chx_idx] -= (((float64_t) apparent_energy_vah) * MEASURE_ENERGY_MWS_PER_WH);
+    // Do not wear NVM when totals did not change.
+    if ((active_energy_wh != 0) || (apparent_energy_vah != 0)) {
+        measure_energy.checkpoint_pending = 1;
+    }
+}
+#endif
+
 #ifdef MPMCM_ANALOG_MEASURE_ENABLE
 /*******************************************************************/
 static void _MEASURE_compute_accumulated_data(void) {
@@ -688,6 +1313,10 @@ static void _MEASURE_compute_accumulated_data(void) {
         // Increase apparent energy.
         measure_data.apparent_energy_mvas_sum[chx_idx].value += (measure_data.chx_run_data[chx_idx].apparent_power_mva.value);
         measure_data.apparent_energy_mvas_sum[chx_idx].number_of_samples++;
+#ifdef MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS
+        // Increase energy totals.
+        _MEASURE_update_energy_totals(chx_idx);
+#endif
         // Reset results.
         DATA_reset_run_channel(measure_data.chx_rolling_mean[chx_idx]);
     }
@@ -793,18 +1422,16 @@ static MEASURE_status_t _MEASURE_internal_process(void) {
         if (measure_ctx.zero_cross_count >= MEASURE_ZERO_CROSS_PER_PERIOD) {
             // Clear counters.
             measure_ctx.zero_cross_count = 0;
-            measure_ctx.dma_transfer_end_flag = 0;
-            // Switch to next buffer.
-            status = _MEASURE_switch_dma_buffer();
+            // Record period boundary.
+            // Note: period data is computed later in the main context by the MEASURE_process() function.
+            status = _MEASURE_set_period_boundary();
             if (status != MEASURE_SUCCESS) goto errors;
-            // Compute data.
-            _MEASURE_compute_period_data();
         }
-        // Check DMA transfer end flag.
-        if (measure_ctx.dma_transfer_end_flag != 0) {
+        // Check mains loss flag.
+        if (measure_ctx.mains_loss_flag != 0) {
             // Clear counters and flags.
             measure_ctx.zero_cross_count = 0;
-            measure_ctx.dma_transfer_end_flag = 0;
+            measure_ctx.mains_loss_flag = 0;
             measure_ctx.sampled_period_count = 0;
             measure_ctx.period_compute_enable = 0;
             // Start off period.
@@ -848,6 +1475,10 @@ MEASURE_status_t MEASURE_init(void) {
         GPIO_configure(MEASURE_GPIO_ACI_DETECT[chx_idx], GPIO_MODE_INPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
         measure_ctx.probe_detect_flag[chx_idx] = 0;
     }
+#endif
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS))
+    // Restore energy totals from the last checkpoint.
+    status = _MEASURE_restore_energy_totals();
 #endif
     return status;
 }
@@ -881,28 +1512,35 @@ MEASURE_state_t MEASURE_get_state(void) {
 MEASURE_status_t MEASURE_set_gains(uint16_t transformer_gain, uint16_t current_sensors_gain[MEASURE_NUMBER_OF_ACI_CHANNELS]) {
     // Local variables.
     MEASURE_status_t status = MEASURE_SUCCESS;
+    float64_t acv_factor_num = 0.0;
+    float64_t acv_factor_den = 0.0;
+    float64_t aci_factor_num = 0.0;
+    float64_t aci_factor_den = 0.0;
     uint8_t chx_idx = 0;
     // Check parameters.
     if (current_sensors_gain == NULL) {
         status = MEASURE_ERROR_NULL_PARAMETER;
         goto errors;
     }
+    // Note: factors are computed in double precision and stored with the precision used by the period computation.
     // ACV.
-    measure_data.acv_factor_num = ((float64_t) transformer_gain * (float64_t) MPMCM_TRANSFORMER_ATTENUATOR_VV * (float64_t) STM32G4XX_DRIVERS_ADC_VREF_MV);
-    measure_data.acv_factor_den = ((float64_t) MEASURE_TRANSFORMER_GAIN_FACTOR * (float64_t) ADC_FULL_SCALE);
+    acv_factor_num = ((float64_t) transformer_gain * (float64_t) MPMCM_TRANSFORMER_ATTENUATOR_VV * (float64_t) STM32G4XX_DRIVERS_ADC_VREF_MV);
+    acv_factor_den = ((float64_t) MEASURE_TRANSFORMER_GAIN_FACTOR * (float64_t) ADC_FULL_SCALE);
+    measure_data.acv_factor_num = (MEASURE_float_t) acv_factor_num;
+    measure_data.acv_factor_den = (MEASURE_float_t) acv_factor_den;
     // ACI.
+    aci_factor_den = ((float64_t) MEASURE_CURRENT_SENSOR_GAIN_FACTOR * (float64_t) ADC_FULL_SCALE);
+    measure_data.aci_factor_den = (MEASURE_float_t) aci_factor_den;
     for (chx_idx = 0; chx_idx < MEASURE_NUMBER_OF_ACI_CHANNELS; chx_idx++) {
-        measure_data.aci_factor_num[chx_idx] = ((float64_t) current_sensors_gain[chx_idx] * (float64_t) MEASURE_CURRENT_SENSOR_ATTENUATOR[chx_idx] * (float64_t) STM32G4XX_DRIVERS_ADC_VREF_MV);
-    }
-    measure_data.aci_factor_den = ((float64_t) MEASURE_CURRENT_SENSOR_GAIN_FACTOR * (float64_t) ADC_FULL_SCALE);
-    // ACP.
-    for (chx_idx = 0; chx_idx < MEASURE_NUMBER_OF_ACI_CHANNELS; chx_idx++) {
+        aci_factor_num = ((float64_t) current_sensors_gain[chx_idx] * (float64_t) MEASURE_CURRENT_SENSOR_ATTENUATOR[chx_idx] * (float64_t) STM32G4XX_DRIVERS_ADC_VREF_MV);
+        measure_data.aci_factor_num[chx_idx] = (MEASURE_float_t) aci_factor_num;
+        // ACP.
         // Note: 1000 factor is used to get mW from mV and mA.
         // Conversion is done here to limit numerator value and avoid overflow during power computation.
         // There is no precision loss since ACV and ACI factors multiplication is necessarily a multiple of 1000 thanks to ADC_VREF_MV.
-        measure_data.acp_factor_num[chx_idx] = (measure_data.acv_factor_num * measure_data.aci_factor_num[chx_idx]) / ((float64_t) 1000);
+        measure_data.acp_factor_num[chx_idx] = (MEASURE_float_t) ((acv_factor_num * aci_factor_num) / ((float64_t) 1000));
     }
-    measure_data.acp_factor_den = (measure_data.acv_factor_den * measure_data.aci_factor_den);
+    measure_data.acp_factor_den = (MEASURE_float_t) (acv_factor_den * aci_factor_den);
     // Buffer size limits.
     measure_data.period_acxx_buffer_size_low_limit = ((100 - MEASURE_PERIOD_ADCX_BUFFER_SIZE_ERROR_PERCENT) * MEASURE_PERIOD_BUFFER_SIZE) / (100);
     measure_data.period_acxx_buffer_size_high_limit = ((100 + MEASURE_PERIOD_ADCX_BUFFER_SIZE_ERROR_PERCENT) * MEASURE_PERIOD_BUFFER_SIZE) / (100);
@@ -915,10 +1553,18 @@ errors:
 MEASURE_status_t MEASURE_tick_second(void) {
     // Local variables.
     MEASURE_status_t status = MEASURE_SUCCESS;
+#ifdef MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS
+    MEASURE_status_t measure_status = MEASURE_SUCCESS;
+#endif
     // Increment seconds count.
     measure_ctx.tick_led_seconds_count++;
 #ifdef MPMCM_ANALOG_SIMULATION
     measure_ctx.random_divider = 1 + ((measure_ctx.random_divider + 1) % 100);
+#endif
+#ifdef MPMCM_ANALOG_MEASURE_PROFILING
+    // Update computation throughput.
+    measure_ctx.profiling.periods_per_second = measure_ctx.profiling_period_count;
+    measure_ctx.profiling_period_count = 0;
 #endif
     // Check state.
     if ((measure_ctx.state == MEASURE_STATE_ACTIVE) && (measure_ctx.period_compute_enable != 0)) {
@@ -934,6 +1580,54 @@ MEASURE_status_t MEASURE_tick_second(void) {
     }
     // Blink LED.
     _MEASURE_led_single_pulse();
+#ifdef MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS
+    // Periodic energy totals checkpoint.
+    measure_energy.checkpoint_seconds_count++;
+    if (measure_energy.checkpoint_seconds_count >= MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS) {
+        // Reset count.
+        measure_energy.checkpoint_seconds_count = 0;
+        // Store totals.
+        if (measure_energy.checkpoint_pending != 0) {
+            measure_status = _MEASURE_store_energy_totals();
+            MEASURE_stack_error(ERROR_BASE_MEASURE);
+        }
+    }
+#endif
+    return status;
+}
+#endif
+
+#ifdef MPMCM_ANALOG_MEASURE_ENABLE
+/*******************************************************************/
+MEASURE_status_t MEASURE_process(void) {
+    // Local variables.
+    MEASURE_status_t status = MEASURE_SUCCESS;
+    MEASURE_period_t period;
+    uint32_t read_count = 0;
+    uint32_t primask = 0;
+    uint8_t period_available = 0;
+    // Consume all pending periods.
+    do {
+        // Copy next descriptor with interrupts masked since the queue can be written or flushed concurrently.
+        CRITICAL_enter(primask);
+        read_count = measure_sampling.period_queue_read_count;
+        period_available = (read_count != measure_sampling.period_queue_write_count) ? 1 : 0;
+        if (period_available != 0) {
+            period = measure_sampling.period_queue[read_count % MEASURE_PERIOD_QUEUE_SIZE];
+        }
+        CRITICAL_exit(primask);
+        if (period_available == 0) break;
+        // Compute data.
+        // Note: periods overwritten by the DMA while waiting in the queue are discarded by the computation itself.
+        _MEASURE_compute_period_data(&period);
+        // Release queue slot only if the queue has not been flushed during the computation.
+        CRITICAL_enter(primask);
+        if (measure_sampling.period_queue_read_count == read_count) {
+            measure_sampling.period_queue_read_count++;
+        }
+        CRITICAL_exit(primask);
+    }
+    while (period_available != 0);
     return status;
 }
 #endif
@@ -1078,4 +1772,83 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+MEASURE_status_t MEASURE_get_period_queue_statistics(MEASURE_period_queue_statistics_t* period_queue_statistics) {
+    // Local variables.
+    MEASURE_status_t status = MEASURE_SUCCESS;
+    uint32_t primask = 0;
+    // Check parameter.
+    if (period_queue_statistics == NULL) {
+        status = MEASURE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Copy data atomically since statistics are updated by the zero cross interrupt.
+    CRITICAL_enter(primask);
+    (*period_queue_statistics) = measure_ctx.period_queue_statistics;
+    CRITICAL_exit(primask);
+errors:
+    return status;
+}
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS))
+/*******************************************************************/
+MEASURE_status_t MEASURE_get_channel_energy_total(uint8_t channel, int32_t* active_energy_wh, int32_t* apparent_energy_vah) {
+    // Local variables.
+    MEASURE_status_t status = MEASURE_SUCCESS;
+    // Check parameters.
+    if ((active_energy_wh == NULL) || (apparent_energy_vah == NULL)) {
+        status = MEASURE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (channel >= MEASURE_NUMBER_OF_ACI_CHANNELS) {
+        status = MEASURE_ERROR_AC_CHANNEL;
+        goto errors;
+    }
+    // Read totals.
+    (*active_energy_wh) = measure_energy.active_energy_wh_total[channel];
+    (*apparent_energy_vah) = measure_energy.apparent_energy_vah_total[channel];
+errors:
+    return status;
+}
+#endif
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ANALOG_MEASURE_HARMONICS))
+/*******************************************************************/
+MEASURE_status_t MEASURE_get_channel_harmonics_data(uint8_t channel, MEASURE_harmonics_data_t* channel_harmonics_data) {
+    // Local variables.
+    MEASURE_status_t status = MEASURE_SUCCESS;
+    uint8_t rank_idx = 0;
+    // Check parameters.
+    if (channel_harmonics_data == NULL) {
+        status = MEASURE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (channel >= MEASURE_NUMBER_OF_ACI_CHANNELS) {
+        status = MEASURE_ERROR_AC_CHANNEL;
+        goto errors;
+    }
+    // Copy data.
+    _MEASURE_copy_harmonics_data(measure_data.chx_harmonics_run_data[channel], (*channel_harmonics_data));
+errors:
+    return status;
+}
+#endif
+
+#if ((defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ANALOG_MEASURE_PROFILING))
+/*******************************************************************/
+MEASURE_status_t MEASURE_get_profiling_data(MEASURE_profiling_t* profiling_data) {
+    // Local variables.
+    MEASURE_status_t status = MEASURE_SUCCESS;
+    // Check parameter.
+    if (profiling_data == NULL) {
+        status = MEASURE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Copy data.
+    (*profiling_data) = measure_ctx.profiling;
+errors:
+    return status;
+}
+#endif
+
 #endif /* MPMCM */
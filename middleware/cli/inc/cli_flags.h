@@ -0,0 +1,50 @@
+/*
+ * cli_flags.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __CLI_FLAGS_H__
+#define __CLI_FLAGS_H__
+
+#include "dsm_flags.h"
+
+/*** CLI compilation flags ***/
+
+#ifdef DSM_CLI_BULK_ACCESS
+#define CLI_BULK_ACCESS
+#endif
+#ifdef DSM_ERROR_LOG
+#define CLI_ERROR_LOG
+#endif
+#ifdef DSM_SCHEDULER_STATISTICS
+#define CLI_SCHEDULER
+#endif
+#if ((defined MPMCM) && (defined MPMCM_ANALOG_MEASURE_ENABLE))
+#define CLI_MEASURE_QUEUE
+#endif
+#if ((defined MPMCM) && (defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ANALOG_MEASURE_PROFILING))
+#define CLI_MEASURE_PROFILING
+#endif
+#if ((defined MPMCM) && (defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ENERGY_CHECKPOINT_PERIOD_SECONDS))
+#define CLI_MEASURE_ENERGY
+#endif
+#if ((defined MPMCM) && (defined MPMCM_ANALOG_MEASURE_ENABLE) && (defined MPMCM_ANALOG_MEASURE_HARMONICS))
+#define CLI_MEASURE_HARMONICS
+#endif
+#if ((defined MPMCM) && (defined MPMCM_LINKY_TIC_ENABLE))
+#define CLI_TIC
+#endif
+#if ((defined UHFM) && (defined UHFM_UPLINK_QUEUE_DEPTH))
+#define CLI_UPLINK_QUEUE
+#endif
+#if (((defined BCM) && (defined BCM_STORAGE_CAPACITY_MAH)) || ((defined BPSM) && (defined BPSM_STORAGE_CAPACITY_MAH)))
+#define CLI_GAUGE
+#endif
+
+#if ((defined CLI_BULK_ACCESS) || (defined CLI_ERROR_LOG) || (defined CLI_SCHEDULER) || (defined CLI_MEASURE_QUEUE) || (defined CLI_MEASURE_PROFILING) || (defined CLI_MEASURE_ENERGY) || (defined CLI_MEASURE_HARMONICS) || (defined CLI_TIC) || (defined CLI_UPLINK_QUEUE) || (defined CLI_GAUGE))
+#define CLI_CUSTOM_COMMANDS
+#endif
+
+#endif /* __CLI_FLAGS_H__ */
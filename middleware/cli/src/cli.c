@@ -8,24 +8,197 @@
 #include "cli.h"
 
 #include "at.h"
+#include "cli_flags.h"
+#include "dsm_flags.h"
 #include "error.h"
 #include "error_base.h"
+#include "error_log.h"
+#if ((defined BCM) || (defined BPSM))
+#include "gauge.h"
+#endif
+#ifdef MPMCM
+#include "measure.h"
+#endif
+#ifdef UHFM
+#include "uhfm.h"
+#endif
 #include "node.h"
+#include "node_register.h"
+#include "parser.h"
+#include "scheduler.h"
+#include "strings.h"
+#ifdef MPMCM
+#include "tic.h"
+#endif
 #include "una.h"
 #include "una_at.h"
 #include "types.h"
 
+/*** CLI local macros ***/
+
+#ifdef CLI_BULK_ACCESS
+#define CLI_BULK_ACCESS_REGISTERS_PER_REPLY     8
+#endif
+#ifdef CLI_ERROR_LOG
+#define CLI_ERROR_LOG_RECORDS_PER_PAGE          4
+#endif
+
 /*** CLI local structures ***/
 
 /*******************************************************************/
 typedef struct {
     volatile uint8_t una_at_process_flag;
+#ifdef UNA_AT_CUSTOM_COMMANDS
+    PARSER_context_t* at_parser_ptr;
+#endif
 } CLI_context_t;
 
+/*** CLI local functions declaration ***/
+
+#ifdef CLI_BULK_ACCESS
+static AT_status_t _CLI_read_range_callback(void);
+static AT_status_t _CLI_read_list_callback(void);
+static AT_status_t _CLI_write_range_callback(void);
+#endif
+#ifdef CLI_ERROR_LOG
+static AT_status_t _CLI_error_log_read_callback(void);
+static AT_status_t _CLI_error_log_clear_callback(void);
+#endif
+#ifdef CLI_SCHEDULER
+static AT_status_t _CLI_scheduler_callback(void);
+#endif
+#ifdef CLI_MEASURE_QUEUE
+static AT_status_t _CLI_measure_queue_callback(void);
+#endif
+#ifdef CLI_MEASURE_PROFILING
+static AT_status_t _CLI_measure_profiling_callback(void);
+#endif
+#ifdef CLI_MEASURE_ENERGY
+static AT_status_t _CLI_measure_energy_callback(void);
+#endif
+#ifdef CLI_MEASURE_HARMONICS
+static AT_status_t _CLI_measure_harmonics_callback(void);
+#endif
+#ifdef CLI_TIC
+static AT_status_t _CLI_tic_callback(void);
+#endif
+#ifdef CLI_UPLINK_QUEUE
+static AT_status_t _CLI_uplink_queue_callback(void);
+#endif
+#ifdef CLI_GAUGE
+static AT_status_t _CLI_gauge_callback(void);
+#endif
+
 /*** CLI local global variables ***/
 
+#ifdef UNA_AT_CUSTOM_COMMANDS
+static const AT_command_t CLI_COMMANDS_LIST[] = {
+#ifdef CLI_BULK_ACCESS
+    {
+        .syntax = "$RR=",
+        .parameters = "<reg_addr[hex]>,<number_of_registers[hex]>",
+        .description = "Read consecutive registers",
+        .callback = &_CLI_read_range_callback
+    },
+    {
+        .syntax = "$RL=",
+        .parameters = "<number_of_registers[hex]>,<reg_addr_0[hex]>,...",
+        .description = "Read a list of registers",
+        .callback = &_CLI_read_list_callback
+    },
+    {
+        .syntax = "$WR=",
+        .parameters = "<reg_addr[hex]>,<number_of_registers[hex]>,<reg_value_0[hex]>,...",
+        .description = "Write consecutive registers",
+        .callback = &_CLI_write_range_callback
+    },
+#endif
+#ifdef CLI_ERROR_LOG
+    {
+        .syntax = "$EL=",
+        .parameters = "<source[dec]>,<page[dec]>",
+        .description = "Read error log page (source 0 = RAM, 1 = NVM)",
+        .callback = &_CLI_error_log_read_callback
+    },
+    {
+        .syntax = "$ELC",
+        .parameters = NULL,
+        .description = "Clear error log",
+        .callback = &_CLI_error_log_clear_callback
+    },
+#endif
+#ifdef CLI_SCHEDULER
+    {
+        .syntax = "$SCH?",
+        .parameters = NULL,
+        .description = "Read scheduler wakeup statistics",
+        .callback = &_CLI_scheduler_callback
+    },
+#endif
+#ifdef CLI_MEASURE_QUEUE
+    {
+        .syntax = "$PQS?",
+        .parameters = NULL,
+        .description = "Read periods queue statistics",
+        .callback = &_CLI_measure_queue_callback
+    },
+#endif
+#ifdef CLI_MEASURE_PROFILING
+    {
+        .syntax = "$PRF?",
+        .parameters = NULL,
+        .description = "Read period computation profiling data",
+        .callback = &_CLI_measure_profiling_callback
+    },
+#endif
+#ifdef CLI_MEASURE_ENERGY
+    {
+        .syntax = "$NRG?",
+        .parameters = NULL,
+        .description = "Read AC channels energy totals",
+        .callback = &_CLI_measure_energy_callback
+    },
+#endif
+#ifdef CLI_MEASURE_HARMONICS
+    {
+        .syntax = "$HRM?",
+        .parameters = NULL,
+        .description = "Read AC channels THD and harmonics levels in 0.1%",
+        .callback = &_CLI_measure_harmonics_callback
+    },
+#endif
+#ifdef CLI_TIC
+    {
+        .syntax = "$TIC?",
+        .parameters = NULL,
+        .description = "Read TIC energy index, checksum errors and buffer overruns",
+        .callback = &_CLI_tic_callback
+    },
+#endif
+#ifdef CLI_UPLINK_QUEUE
+    {
+        .syntax = "$ULQ?",
+        .parameters = NULL,
+        .description = "Read uplink queue status",
+        .callback = &_CLI_uplink_queue_callback
+    },
+#endif
+#ifdef CLI_GAUGE
+    {
+        .syntax = "$SOC?",
+        .parameters = NULL,
+        .description = "Read storage element state of charge",
+        .callback = &_CLI_gauge_callback
+    },
+#endif
+};
+#endif
+
 static CLI_context_t cli_ctx = {
-    .una_at_process_flag = 0
+    .una_at_process_flag = 0,
+#ifdef UNA_AT_CUSTOM_COMMANDS
+    .at_parser_ptr = NULL
+#endif
 };
 
 /*** CLI local functions ***/
@@ -46,6 +219,8 @@ static CLI_context_t cli_ctx = {
 static void _CLI_una_at_process_callback(void) {
     // Set local flag.
     cli_ctx.una_at_process_flag = 1;
+    // Wake-up command task.
+    SCHEDULER_post_event(SCHEDULER_TASK_CLI);
 }
 
 /*******************************************************************/
@@ -72,6 +247,476 @@ errors:
     return status;
 }
 
+#ifdef CLI_BULK_ACCESS
+/*******************************************************************/
+static AT_status_t _CLI_get_bulk_parameter(uint8_t parameter_idx, uint8_t number_of_parameters, int32_t* value) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    char_t separator = ((parameter_idx + 1) >= number_of_parameters) ? STRING_CHAR_NULL : STRING_CHAR_COMMA;
+    // Parse parameter.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_HEXADECIMAL, separator, value);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_BULK_ACCESS
+/*******************************************************************/
+static AT_status_t _CLI_reply_add_register(uint8_t reg_addr, uint8_t reply_idx, uint8_t number_of_registers) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    NODE_status_t node_status = NODE_SUCCESS;
+    uint32_t reg_value = 0;
+    // Read register.
+    node_status = NODE_read_register(reg_addr, &reg_value);
+    _CLI_check_driver_status(node_status, NODE_SUCCESS, ERROR_BASE_NODE);
+    // Add value to the current line.
+    if ((reply_idx % CLI_BULK_ACCESS_REGISTERS_PER_REPLY) != 0) {
+        AT_reply_add_string(",");
+    }
+    AT_reply_add_integer((int32_t) reg_value, STRING_FORMAT_HEXADECIMAL, 0);
+    // Send line when full or at the end of the transaction.
+    if ((((reply_idx + 1) % CLI_BULK_ACCESS_REGISTERS_PER_REPLY) == 0) || ((reply_idx + 1) >= number_of_registers)) {
+        AT_send_reply();
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_BULK_ACCESS
+/*******************************************************************/
+static AT_status_t _CLI_read_range_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    int32_t reg_addr = 0;
+    int32_t number_of_registers = 0;
+    uint8_t idx = 0;
+    // Read parameters.
+    status = _CLI_get_bulk_parameter(0, 2, &reg_addr);
+    if (status != AT_SUCCESS) goto errors;
+    status = _CLI_get_bulk_parameter(1, 2, &number_of_registers);
+    if (status != AT_SUCCESS) goto errors;
+    // Check range.
+    if ((reg_addr < 0) || (number_of_registers <= 0) || ((reg_addr + number_of_registers) > NODE_REGISTER_ADDRESS_LAST)) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+    // Registers loop.
+    for (idx = 0; idx < ((uint8_t) number_of_registers); idx++) {
+        status = _CLI_reply_add_register((uint8_t) (reg_addr + idx), idx, (uint8_t) number_of_registers);
+        if (status != AT_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_BULK_ACCESS
+/*******************************************************************/
+static AT_status_t _CLI_read_list_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    int32_t number_of_registers = 0;
+    int32_t reg_addr = 0;
+    uint8_t idx = 0;
+    // Read number of registers.
+    status = _CLI_get_bulk_parameter(0, 2, &number_of_registers);
+    if (status != AT_SUCCESS) goto errors;
+    // Check parameter.
+    if ((number_of_registers <= 0) || (number_of_registers > NODE_REGISTER_ADDRESS_LAST)) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+    // Registers loop.
+    for (idx = 0; idx < ((uint8_t) number_of_registers); idx++) {
+        // Read address.
+        status = _CLI_get_bulk_parameter((idx + 1), (uint8_t) (number_of_registers + 1), &reg_addr);
+        if (status != AT_SUCCESS) goto errors;
+        // Check address.
+        if ((reg_addr < 0) || (reg_addr >= NODE_REGISTER_ADDRESS_LAST)) {
+            status = AT_ERROR_COMMAND_EXECUTION;
+            goto errors;
+        }
+        status = _CLI_reply_add_register((uint8_t) reg_addr, idx, (uint8_t) number_of_registers);
+        if (status != AT_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_BULK_ACCESS
+/*******************************************************************/
+static AT_status_t _CLI_write_range_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    NODE_status_t node_status = NODE_SUCCESS;
+    int32_t reg_addr = 0;
+    int32_t number_of_registers = 0;
+    int32_t reg_value = 0;
+    uint8_t idx = 0;
+    // Read parameters.
+    status = _CLI_get_bulk_parameter(0, 3, &reg_addr);
+    if (status != AT_SUCCESS) goto errors;
+    status = _CLI_get_bulk_parameter(1, 3, &number_of_registers);
+    if (status != AT_SUCCESS) goto errors;
+    // Check range.
+    if ((reg_addr < 0) || (number_of_registers <= 0) || ((reg_addr + number_of_registers) > NODE_REGISTER_ADDRESS_LAST)) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+    // Registers loop.
+    for (idx = 0; idx < ((uint8_t) number_of_registers); idx++) {
+        // Read value.
+        status = _CLI_get_bulk_parameter((idx + 2), (uint8_t) (number_of_registers + 2), &reg_value);
+        if (status != AT_SUCCESS) goto errors;
+        // Write register.
+        node_status = NODE_write_register((uint8_t) (reg_addr + idx), (uint32_t) reg_value, UNA_REGISTER_MASK_ALL);
+        _CLI_check_driver_status(node_status, NODE_SUCCESS, ERROR_BASE_NODE);
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_ERROR_LOG
+/*******************************************************************/
+static AT_status_t _CLI_error_log_read_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    ERROR_LOG_status_t error_log_status = ERROR_LOG_SUCCESS;
+    ERROR_LOG_record_t record;
+    int32_t source = 0;
+    int32_t page = 0;
+    uint8_t number_of_records = 0;
+    uint8_t record_index = 0;
+    uint8_t idx = 0;
+    // Read parameters.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_COMMA, &source);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &page);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Check parameters.
+    if ((source < 0) || (source >= ERROR_LOG_SOURCE_LAST) || (page < 0) || (page >= ((ERROR_LOG_RAM_DEPTH + CLI_ERROR_LOG_RECORDS_PER_PAGE - 1) / CLI_ERROR_LOG_RECORDS_PER_PAGE))) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+    // Import pending errors.
+    ERROR_LOG_import_stack();
+    number_of_records = ERROR_LOG_get_number_of_records((ERROR_LOG_source_t) source);
+    // Records loop.
+    for (idx = 0; idx < CLI_ERROR_LOG_RECORDS_PER_PAGE; idx++) {
+        record_index = (uint8_t) ((page * CLI_ERROR_LOG_RECORDS_PER_PAGE) + idx);
+        if (record_index >= number_of_records) break;
+        error_log_status = ERROR_LOG_get_record((ERROR_LOG_source_t) source, record_index, &record);
+        _CLI_check_driver_status(error_log_status, ERROR_LOG_SUCCESS, ERROR_BASE_ERROR_LOG);
+        // Print record.
+        AT_reply_add_integer((int32_t) record_index, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(":");
+        AT_reply_add_integer((int32_t) record.code, STRING_FORMAT_HEXADECIMAL, 1);
+        AT_reply_add_string(",");
+        AT_reply_add_integer((int32_t) record.number_of_occurrences, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(",");
+        AT_reply_add_integer((int32_t) record.time_seconds, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string("s");
+        AT_send_reply();
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_ERROR_LOG
+/*******************************************************************/
+static AT_status_t _CLI_error_log_clear_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    ERROR_LOG_status_t error_log_status = ERROR_LOG_SUCCESS;
+    // Clear log.
+    error_log_status = ERROR_LOG_clear();
+    _CLI_check_driver_status(error_log_status, ERROR_LOG_SUCCESS, ERROR_BASE_ERROR_LOG);
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_SCHEDULER
+/*******************************************************************/
+static AT_status_t _CLI_scheduler_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    SCHEDULER_statistics_t statistics;
+    uint8_t idx = 0;
+    // Read statistics.
+    SCHEDULER_get_statistics(&statistics);
+    // Print wakeups.
+    AT_reply_add_string("WAKE=");
+    AT_reply_add_integer((int32_t) statistics.number_of_wakeups, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",IDLE=");
+    AT_reply_add_integer((int32_t) statistics.number_of_idle_wakeups, STRING_FORMAT_DECIMAL, 0);
+    AT_send_reply();
+    // Print tasks runs.
+    for (idx = 0; idx < SCHEDULER_TASK_LAST; idx++) {
+        AT_reply_add_string("TASK");
+        AT_reply_add_integer((int32_t) idx, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string("=EVT:");
+        AT_reply_add_integer((int32_t) statistics.number_of_event_runs[idx], STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string(",DL:");
+        AT_reply_add_integer((int32_t) statistics.number_of_deadline_runs[idx], STRING_FORMAT_DECIMAL, 0);
+        AT_send_reply();
+    }
+    return status;
+}
+#endif
+
+#ifdef CLI_MEASURE_QUEUE
+/*******************************************************************/
+static AT_status_t _CLI_measure_queue_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    MEASURE_status_t measure_status = MEASURE_SUCCESS;
+    MEASURE_period_queue_statistics_t queue_statistics;
+    // Read statistics.
+    measure_status = MEASURE_get_period_queue_statistics(&queue_statistics);
+    _CLI_check_driver_status(measure_status, MEASURE_SUCCESS, ERROR_BASE_MEASURE);
+    // Print statistics.
+    AT_reply_add_string("PUB=");
+    AT_reply_add_integer((int32_t) queue_statistics.number_of_published_periods, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",DROP=");
+    AT_reply_add_integer((int32_t) queue_statistics.number_of_dropped_periods, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",OVW=");
+    AT_reply_add_integer((int32_t) queue_statistics.number_of_overwritten_periods, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",MAX=");
+    AT_reply_add_integer((int32_t) queue_statistics.max_pending_periods, STRING_FORMAT_DECIMAL, 0);
+    AT_send_reply();
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_MEASURE_PROFILING
+/*******************************************************************/
+static AT_status_t _CLI_measure_profiling_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    MEASURE_status_t measure_status = MEASURE_SUCCESS;
+    MEASURE_profiling_t profiling_data;
+    // Read profiling data.
+    measure_status = MEASURE_get_profiling_data(&profiling_data);
+    _CLI_check_driver_status(measure_status, MEASURE_SUCCESS, ERROR_BASE_MEASURE);
+    // Print cycles.
+    AT_reply_add_string("cycles=");
+    AT_reply_add_integer((int32_t) profiling_data.period_cycles_last, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",");
+    AT_reply_add_integer((int32_t) profiling_data.period_cycles_min, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",");
+    AT_reply_add_integer((int32_t) profiling_data.period_cycles_max, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",");
+    AT_reply_add_integer((int32_t) profiling_data.period_cycles_mean, STRING_FORMAT_DECIMAL, 0);
+    AT_send_reply();
+    // Print periods rate.
+    AT_reply_add_string("periods=");
+    AT_reply_add_integer((int32_t) profiling_data.number_of_periods, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",");
+    AT_reply_add_integer((int32_t) profiling_data.periods_per_second, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("/s");
+    AT_send_reply();
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_MEASURE_ENERGY
+/*******************************************************************/
+static AT_status_t _CLI_measure_energy_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    MEASURE_status_t measure_status = MEASURE_SUCCESS;
+    int32_t active_energy_wh = 0;
+    int32_t apparent_energy_vah = 0;
+    uint8_t chx_idx = 0;
+    // Channels loop.
+    for (chx_idx = 0; chx_idx < MEASURE_NUMBER_OF_ACI_CHANNELS; chx_idx++) {
+        // Read totals.
+        measure_status = MEASURE_get_channel_energy_total(chx_idx, &active_energy_wh, &apparent_energy_vah);
+        _CLI_check_driver_status(measure_status, MEASURE_SUCCESS, ERROR_BASE_MEASURE);
+        // Print totals.
+        AT_reply_add_string("CH");
+        AT_reply_add_integer((int32_t) (chx_idx + 1), STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string("=");
+        AT_reply_add_integer(active_energy_wh, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string("Wh,");
+        AT_reply_add_integer(apparent_energy_vah, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string("VAh");
+        AT_send_reply();
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_MEASURE_HARMONICS
+/*******************************************************************/
+static void _CLI_print_harmonics(DATA_run_t* thd_percent, DATA_run_t* harmonic_percent) {
+    // Local variables.
+    uint8_t rank_idx = 0;
+    // Check data.
+    if (thd_percent->number_of_samples == 0) {
+        AT_reply_add_string("NA");
+        goto errors;
+    }
+    // THD followed by rank 2 to last rank levels.
+    AT_reply_add_integer((int32_t) ((thd_percent->value) * 10.0), STRING_FORMAT_DECIMAL, 0);
+    for (rank_idx = 0; rank_idx < MEASURE_NUMBER_OF_HARMONICS; rank_idx++) {
+        AT_reply_add_string(",");
+        AT_reply_add_integer((int32_t) ((harmonic_percent[rank_idx].value) * 10.0), STRING_FORMAT_DECIMAL, 0);
+    }
+errors:
+    return;
+}
+#endif
+
+#ifdef CLI_MEASURE_HARMONICS
+/*******************************************************************/
+static AT_status_t _CLI_measure_harmonics_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    MEASURE_status_t measure_status = MEASURE_SUCCESS;
+    MEASURE_harmonics_data_t harmonics_data;
+    uint8_t chx_idx = 0;
+    // Channels loop.
+    for (chx_idx = 0; chx_idx < MEASURE_NUMBER_OF_ACI_CHANNELS; chx_idx++) {
+        // Read last run data.
+        measure_status = MEASURE_get_channel_harmonics_data(chx_idx, &harmonics_data);
+        _CLI_check_driver_status(measure_status, MEASURE_SUCCESS, ERROR_BASE_MEASURE);
+        // Print voltage and current levels.
+        AT_reply_add_string("CH");
+        AT_reply_add_integer((int32_t) (chx_idx + 1), STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string("=V:");
+        _CLI_print_harmonics(&(harmonics_data.voltage_thd_percent), harmonics_data.voltage_harmonic_percent);
+        AT_reply_add_string(",I:");
+        _CLI_print_harmonics(&(harmonics_data.current_thd_percent), harmonics_data.current_harmonic_percent);
+        AT_send_reply();
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_TIC
+/*******************************************************************/
+static AT_status_t _CLI_tic_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    TIC_status_t tic_status = TIC_SUCCESS;
+    DATA_run_t energy_index_wh;
+    uint32_t checksum_error_count = 0;
+    uint32_t buffer_overrun_count = 0;
+    // Read TIC data.
+    tic_status = TIC_get_energy_index(&energy_index_wh);
+    _CLI_check_driver_status(tic_status, TIC_SUCCESS, ERROR_BASE_TIC);
+    tic_status = TIC_get_checksum_error_count(&checksum_error_count);
+    _CLI_check_driver_status(tic_status, TIC_SUCCESS, ERROR_BASE_TIC);
+    tic_status = TIC_get_buffer_overrun_count(&buffer_overrun_count);
+    _CLI_check_driver_status(tic_status, TIC_SUCCESS, ERROR_BASE_TIC);
+    // Print data.
+    AT_reply_add_string("IDX=");
+    if (energy_index_wh.number_of_samples == 0) {
+        AT_reply_add_string("NA");
+    }
+    else {
+        AT_reply_add_integer((int32_t) energy_index_wh.value, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string("Wh");
+    }
+    AT_reply_add_string(",CKS=");
+    AT_reply_add_integer((int32_t) checksum_error_count, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",OVR=");
+    AT_reply_add_integer((int32_t) buffer_overrun_count, STRING_FORMAT_DECIMAL, 0);
+    AT_send_reply();
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_UPLINK_QUEUE
+/*******************************************************************/
+static void _CLI_print_uplink_queue_id(int32_t id) {
+    // Check identifier.
+    if (id == UHFM_UPLINK_QUEUE_ID_NONE) {
+        AT_reply_add_string("NA");
+    }
+    else {
+        AT_reply_add_integer(id, STRING_FORMAT_DECIMAL, 0);
+    }
+}
+#endif
+
+#ifdef CLI_UPLINK_QUEUE
+/*******************************************************************/
+static AT_status_t _CLI_uplink_queue_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    NODE_status_t node_status = NODE_SUCCESS;
+    UHFM_uplink_queue_status_t queue_status;
+    // Read queue status.
+    node_status = UHFM_get_uplink_queue_status(&queue_status);
+    _CLI_check_driver_status(node_status, NODE_SUCCESS, ERROR_BASE_NODE);
+    // Print status.
+    AT_reply_add_string("DEPTH=");
+    AT_reply_add_integer((int32_t) queue_status.depth, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("/");
+    AT_reply_add_integer((int32_t) UHFM_UPLINK_QUEUE_DEPTH, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",DROP=");
+    AT_reply_add_integer((int32_t) queue_status.drop_count, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(",DUP=");
+    AT_reply_add_integer((int32_t) queue_status.duplicate_count, STRING_FORMAT_DECIMAL, 0);
+    AT_send_reply();
+    // Print entries identifiers.
+    AT_reply_add_string("QID=");
+    _CLI_print_uplink_queue_id(queue_status.last_queued_id);
+    AT_reply_add_string(",SID=");
+    _CLI_print_uplink_queue_id(queue_status.last_sent_id);
+    AT_send_reply();
+errors:
+    return status;
+}
+#endif
+
+#ifdef CLI_GAUGE
+/*******************************************************************/
+static AT_status_t _CLI_gauge_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    NODE_status_t node_status = NODE_SUCCESS;
+    GAUGE_data_t gauge_data;
+    // Read estimated state.
+    node_status = GAUGE_get_data(&gauge_data);
+    _CLI_check_driver_status(node_status, NODE_SUCCESS, ERROR_BASE_NODE);
+    // Print data.
+    AT_reply_add_string("SOC=");
+    AT_reply_add_integer((int32_t) gauge_data.soc_percent, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("%,CHG=");
+    AT_reply_add_integer((int32_t) gauge_data.charged_mah, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("mAh,DCHG=");
+    AT_reply_add_integer((int32_t) gauge_data.discharged_mah, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("mAh,RUN=");
+    if (gauge_data.runtime_minutes == GAUGE_RUNTIME_UNKNOWN) {
+        AT_reply_add_string("NA");
+    }
+    else {
+        AT_reply_add_integer((int32_t) gauge_data.runtime_minutes, STRING_FORMAT_DECIMAL, 0);
+        AT_reply_add_string("min");
+    }
+    AT_send_reply();
+errors:
+    return status;
+}
+#endif
+
 /*** CLI functions ***/
 
 /*******************************************************************/
@@ -80,6 +725,10 @@ CLI_status_t CLI_init(void) {
     CLI_status_t status = CLI_SUCCESS;
     UNA_AT_status_t una_at_status = UNA_AT_SUCCESS;
     UNA_AT_configuration_t una_at_config;
+#ifdef UNA_AT_CUSTOM_COMMANDS
+    AT_status_t at_status = AT_SUCCESS;
+    uint8_t idx = 0;
+#endif
     // Init context.
     cli_ctx.una_at_process_flag = 0;
     // Init AT driver.
@@ -88,6 +737,14 @@ CLI_status_t CLI_init(void) {
     una_at_config.read_register_callback = &_CLI_read_register_callback;
     una_at_status = UNA_AT_init(&una_at_config);
     UNA_AT_exit_error(CLI_ERROR_BASE_UNA_AT);
+#ifdef UNA_AT_CUSTOM_COMMANDS
+    // Register custom commands.
+    cli_ctx.at_parser_ptr = UNA_AT_get_parser();
+    for (idx = 0; idx < (sizeof(CLI_COMMANDS_LIST) / sizeof(AT_command_t)); idx++) {
+        at_status = AT_register_command(&(CLI_COMMANDS_LIST[idx]));
+        AT_exit_error(CLI_ERROR_BASE_AT);
+    }
+#endif
 errors:
     return status;
 }
@@ -115,6 +772,8 @@ CLI_status_t CLI_process(void) {
         // Process AT driver.
         una_at_status = UNA_AT_process();
         UNA_AT_exit_error(CLI_ERROR_BASE_UNA_AT);
+        // Registers may have been written.
+        SCHEDULER_post_event(SCHEDULER_TASK_NODE);
     }
 errors:
     return status;
@@ -0,0 +1,147 @@
+/*
+ * error_log.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __ERROR_LOG_H__
+#define __ERROR_LOG_H__
+
+#include "dsm_flags.h"
+#include "error.h"
+#include "nvm.h"
+#include "types.h"
+
+/*** ERROR LOG macros ***/
+
+#define ERROR_LOG_RAM_DEPTH     8
+#define ERROR_LOG_NVM_DEPTH     4
+
+/*** ERROR LOG structures ***/
+
+/*!******************************************************************
+ * \enum ERROR_LOG_status_t
+ * \brief ERROR LOG driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    ERROR_LOG_SUCCESS = 0,
+    ERROR_LOG_ERROR_NULL_PARAMETER,
+    ERROR_LOG_ERROR_SOURCE,
+    ERROR_LOG_ERROR_RECORD_INDEX,
+    // Low level drivers errors.
+    ERROR_LOG_ERROR_BASE_NVM = ERROR_BASE_STEP,
+    // Last base value.
+    ERROR_LOG_ERROR_BASE_LAST = (ERROR_LOG_ERROR_BASE_NVM + NVM_ERROR_BASE_LAST)
+} ERROR_LOG_status_t;
+
+#ifdef DSM_ERROR_LOG
+
+/*!******************************************************************
+ * \enum ERROR_LOG_source_t
+ * \brief Error records sources.
+ *******************************************************************/
+typedef enum {
+    ERROR_LOG_SOURCE_RAM = 0,
+    ERROR_LOG_SOURCE_NVM,
+    ERROR_LOG_SOURCE_LAST
+} ERROR_LOG_source_t;
+
+/*!******************************************************************
+ * \struct ERROR_LOG_record_t
+ * \brief Error record structure.
+ *******************************************************************/
+typedef struct {
+    ERROR_code_t code;
+    uint16_t number_of_occurrences;
+    uint32_t time_seconds;
+} ERROR_LOG_record_t;
+
+/*** ERROR LOG functions ***/
+
+/*!******************************************************************
+ * \fn ERROR_LOG_status_t ERROR_LOG_init(void)
+ * \brief Init error log and load the records stored in NVM.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+ERROR_LOG_status_t ERROR_LOG_init(void);
+
+/*!******************************************************************
+ * \fn ERROR_LOG_status_t ERROR_LOG_process(void)
+ * \brief Import the pending error stack codes and write the modified records in NVM (to be called from the main loop).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+ERROR_LOG_status_t ERROR_LOG_process(void);
+
+/*!******************************************************************
+ * \fn void ERROR_LOG_import_stack(void)
+ * \brief Move the pending error stack codes into the log with their timestamp, without any NVM access.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void ERROR_LOG_import_stack(void);
+
+/*!******************************************************************
+ * \fn ERROR_code_t ERROR_LOG_read(void)
+ * \brief Read the oldest error code which has not been read yet.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Error code (SUCCESS if there is no unread record).
+ *******************************************************************/
+ERROR_code_t ERROR_LOG_read(void);
+
+/*!******************************************************************
+ * \fn uint8_t ERROR_LOG_is_empty(void)
+ * \brief Check if all error records have been read.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      1 if there is no unread record, 0 otherwise.
+ *******************************************************************/
+uint8_t ERROR_LOG_is_empty(void);
+
+/*!******************************************************************
+ * \fn uint8_t ERROR_LOG_get_number_of_records(ERROR_LOG_source_t source)
+ * \brief Get the number of available records.
+ * \param[in]   source: Records source.
+ * \param[out]  none
+ * \retval      Number of records.
+ *******************************************************************/
+uint8_t ERROR_LOG_get_number_of_records(ERROR_LOG_source_t source);
+
+/*!******************************************************************
+ * \fn ERROR_LOG_status_t ERROR_LOG_get_record(ERROR_LOG_source_t source, uint8_t record_index, ERROR_LOG_record_t* record)
+ * \brief Get an error record.
+ * \param[in]   source: Records source.
+ * \param[in]   record_index: Index of the record to read (0 is the most recent one).
+ * \param[out]  record: Pointer to the error record.
+ * \retval      Function execution status.
+ *******************************************************************/
+ERROR_LOG_status_t ERROR_LOG_get_record(ERROR_LOG_source_t source, uint8_t record_index, ERROR_LOG_record_t* record);
+
+/*!******************************************************************
+ * \fn ERROR_LOG_status_t ERROR_LOG_clear(void)
+ * \brief Erase all error records.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+ERROR_LOG_status_t ERROR_LOG_clear(void);
+
+/*******************************************************************/
+#define ERROR_LOG_exit_error(base) { ERROR_check_exit(error_log_status, ERROR_LOG_SUCCESS, base) }
+
+/*******************************************************************/
+#define ERROR_LOG_stack_error(base) { ERROR_check_stack(error_log_status, ERROR_LOG_SUCCESS, base) }
+
+/*******************************************************************/
+#define ERROR_LOG_stack_exit_error(base, code) { ERROR_check_stack_exit(error_log_status, ERROR_LOG_SUCCESS, base, code) }
+
+#endif /* DSM_ERROR_LOG */
+
+#endif /* __ERROR_LOG_H__ */
@@ -0,0 +1,387 @@
+/*
+ * error_log.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "error_log.h"
+
+#include "dsm_flags.h"
+#include "error.h"
+#include "error_base.h"
+#include "nvm.h"
+#include "nvm_address.h"
+#include "rtc.h"
+#include "types.h"
+
+#ifdef DSM_ERROR_LOG
+
+/*** ERROR LOG local macros ***/
+
+#define ERROR_LOG_NVM_HEADER_MAGIC                  0xE10C
+#define ERROR_LOG_NVM_HEADER_WORD_INDEX             0
+#define ERROR_LOG_NVM_RECORDS_WORD_INDEX            1
+#define ERROR_LOG_NVM_RECORD_SIZE_WORDS             2
+
+#define ERROR_LOG_NUMBER_OF_OCCURRENCES_MAX         0xFFFF
+
+#define ERROR_LOG_NVM_UPDATE_PERIOD_SECONDS         3600
+
+/*** ERROR LOG local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    ERROR_LOG_record_t record[ERROR_LOG_RAM_DEPTH];
+    uint8_t write_index;
+    uint8_t number_of_records;
+    uint8_t number_of_unread_records;
+    ERROR_LOG_record_t nvm_record[ERROR_LOG_NVM_DEPTH];
+    uint32_t nvm_record_write_time_seconds[ERROR_LOG_NVM_DEPTH];
+    uint8_t nvm_write_index;
+    uint8_t nvm_number_of_records;
+    uint8_t nvm_dirty_mask;
+    uint8_t nvm_written_mask;
+    uint8_t nvm_header_dirty_flag;
+    uint8_t nvm_disable_flag;
+} ERROR_LOG_context_t;
+
+/*** ERROR LOG local global variables ***/
+
+static ERROR_LOG_context_t error_log_ctx;
+
+/*** ERROR LOG local functions ***/
+
+/*******************************************************************/
+static ERROR_LOG_status_t _ERROR_LOG_read_nvm_word(uint8_t word_index, uint32_t* value) {
+    // Local variables.
+    ERROR_LOG_status_t status = ERROR_LOG_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+#ifdef MPMCM
+    nvm_status = NVM_read_word((NVM_ADDRESS_ERROR_LOG + word_index), value);
+    NVM_exit_error(ERROR_LOG_ERROR_BASE_NVM);
+#else
+    uint8_t nvm_byte = 0;
+    uint8_t idx = 0;
+    // Reset output.
+    (*value) = 0;
+    // Byte loop.
+    for (idx = 0; idx < 4; idx++) {
+        nvm_status = NVM_read_byte((NVM_ADDRESS_ERROR_LOG + (word_index << 2) + idx), &nvm_byte);
+        NVM_exit_error(ERROR_LOG_ERROR_BASE_NVM);
+        (*value) |= ((uint32_t) nvm_byte) << (idx << 3);
+    }
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static ERROR_LOG_status_t _ERROR_LOG_write_nvm_word(uint8_t word_index, uint32_t value) {
+    // Local variables.
+    ERROR_LOG_status_t status = ERROR_LOG_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+#ifdef MPMCM
+    nvm_status = NVM_write_word((NVM_ADDRESS_ERROR_LOG + word_index), value);
+    NVM_exit_error(ERROR_LOG_ERROR_BASE_NVM);
+#else
+    uint8_t idx = 0;
+    // Byte loop.
+    for (idx = 0; idx < 4; idx++) {
+        nvm_status = NVM_write_byte((NVM_ADDRESS_ERROR_LOG + (word_index << 2) + idx), (uint8_t) ((value >> (idx << 3)) & 0x000000FF));
+        NVM_exit_error(ERROR_LOG_ERROR_BASE_NVM);
+    }
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static ERROR_LOG_status_t _ERROR_LOG_write_nvm_header(void) {
+    // Local variables.
+    uint32_t header = 0;
+    // Build header.
+    header |= ((uint32_t) error_log_ctx.nvm_write_index) << 0;
+    header |= ((uint32_t) error_log_ctx.nvm_number_of_records) << 8;
+    header |= ((uint32_t) ERROR_LOG_NVM_HEADER_MAGIC) << 16;
+    return _ERROR_LOG_write_nvm_word(ERROR_LOG_NVM_HEADER_WORD_INDEX, header);
+}
+
+/*******************************************************************/
+static ERROR_LOG_status_t _ERROR_LOG_write_nvm_record(uint8_t nvm_record_index) {
+    // Local variables.
+    ERROR_LOG_status_t status = ERROR_LOG_SUCCESS;
+    ERROR_LOG_record_t* record_ptr = &(error_log_ctx.nvm_record[nvm_record_index]);
+    uint8_t word_index = (ERROR_LOG_NVM_RECORDS_WORD_INDEX + (nvm_record_index * ERROR_LOG_NVM_RECORD_SIZE_WORDS));
+    // Write record.
+    status = _ERROR_LOG_write_nvm_word(word_index, ((uint32_t) (record_ptr->code)) | (((uint32_t) (record_ptr->number_of_occurrences)) << 16));
+    if (status != ERROR_LOG_SUCCESS) goto errors;
+    status = _ERROR_LOG_write_nvm_word((word_index + 1), (record_ptr->time_seconds));
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static ERROR_LOG_status_t _ERROR_LOG_flush_nvm(uint32_t uptime_seconds) {
+    // Local variables.
+    ERROR_LOG_status_t status = ERROR_LOG_SUCCESS;
+    uint8_t idx = 0;
+    // Check NVM availability.
+    if (error_log_ctx.nvm_disable_flag != 0) goto errors;
+    // Records loop.
+    for (idx = 0; idx < ERROR_LOG_NVM_DEPTH; idx++) {
+        // Check if the record has to be written.
+        if ((error_log_ctx.nvm_dirty_mask & (0b1 << idx)) == 0) continue;
+        // Rate limit: a record is written once per boot, then at most once per period.
+        if (((error_log_ctx.nvm_written_mask & (0b1 << idx)) != 0) && ((uptime_seconds - error_log_ctx.nvm_record_write_time_seconds[idx]) < ERROR_LOG_NVM_UPDATE_PERIOD_SECONDS)) continue;
+        // Write record.
+        status = _ERROR_LOG_write_nvm_record(idx);
+        if (status != ERROR_LOG_SUCCESS) goto errors;
+        // Update flags.
+        error_log_ctx.nvm_dirty_mask &= ~(0b1 << idx);
+        error_log_ctx.nvm_written_mask |= (0b1 << idx);
+        error_log_ctx.nvm_record_write_time_seconds[idx] = uptime_seconds;
+    }
+    // Update header once the records are written.
+    if (error_log_ctx.nvm_header_dirty_flag != 0) {
+        status = _ERROR_LOG_write_nvm_header();
+        if (status != ERROR_LOG_SUCCESS) goto errors;
+        error_log_ctx.nvm_header_dirty_flag = 0;
+    }
+errors:
+    // Stop using the NVM after a failure, the error code itself is only kept in RAM.
+    if (status != ERROR_LOG_SUCCESS) {
+        error_log_ctx.nvm_disable_flag = 1;
+    }
+    return status;
+}
+
+/*******************************************************************/
+static void _ERROR_LOG_add_ram(ERROR_code_t code, uint32_t time_seconds) {
+    // Local variables.
+    ERROR_LOG_record_t record;
+    uint8_t oldest_index = ((error_log_ctx.write_index + ERROR_LOG_RAM_DEPTH - error_log_ctx.number_of_records) % ERROR_LOG_RAM_DEPTH);
+    uint8_t record_index = 0;
+    uint8_t idx = 0;
+    // Search code in the stored records.
+    for (idx = 0; idx < error_log_ctx.number_of_records; idx++) {
+        record_index = ((oldest_index + idx) % ERROR_LOG_RAM_DEPTH);
+        if (error_log_ctx.record[record_index].code == code) break;
+    }
+    if (idx < error_log_ctx.number_of_records) {
+        // Only update occurrences counter and timestamp.
+        record = error_log_ctx.record[record_index];
+        if (record.number_of_occurrences < ERROR_LOG_NUMBER_OF_OCCURRENCES_MAX) {
+            record.number_of_occurrences++;
+        }
+        record.time_seconds = time_seconds;
+        // Record becomes unread again if it has already been read.
+        if (idx < (error_log_ctx.number_of_records - error_log_ctx.number_of_unread_records)) {
+            error_log_ctx.number_of_unread_records++;
+        }
+        // Move record to the most recent position.
+        for (; idx < (error_log_ctx.number_of_records - 1); idx++) {
+            record_index = ((oldest_index + idx) % ERROR_LOG_RAM_DEPTH);
+            error_log_ctx.record[record_index] = error_log_ctx.record[(record_index + 1) % ERROR_LOG_RAM_DEPTH];
+        }
+        error_log_ctx.record[(error_log_ctx.write_index + ERROR_LOG_RAM_DEPTH - 1) % ERROR_LOG_RAM_DEPTH] = record;
+    }
+    else {
+        // Create new record (the oldest one is overwritten when the log is full).
+        error_log_ctx.record[error_log_ctx.write_index].code = code;
+        error_log_ctx.record[error_log_ctx.write_index].number_of_occurrences = 1;
+        error_log_ctx.record[error_log_ctx.write_index].time_seconds = time_seconds;
+        error_log_ctx.write_index = ((error_log_ctx.write_index + 1) % ERROR_LOG_RAM_DEPTH);
+        if (error_log_ctx.number_of_records < ERROR_LOG_RAM_DEPTH) {
+            error_log_ctx.number_of_records++;
+        }
+        if (error_log_ctx.number_of_unread_records < ERROR_LOG_RAM_DEPTH) {
+            error_log_ctx.number_of_unread_records++;
+        }
+    }
+}
+
+/*******************************************************************/
+static void _ERROR_LOG_add_nvm(ERROR_code_t code, uint32_t time_seconds) {
+    // Local variables.
+    ERROR_LOG_record_t* record_ptr = NULL;
+    uint8_t oldest_index = ((error_log_ctx.nvm_write_index + ERROR_LOG_NVM_DEPTH - error_log_ctx.nvm_number_of_records) % ERROR_LOG_NVM_DEPTH);
+    uint8_t record_index = 0;
+    uint8_t idx = 0;
+    // Search code in the stored records.
+    for (idx = 0; idx < error_log_ctx.nvm_number_of_records; idx++) {
+        record_index = ((oldest_index + idx) % ERROR_LOG_NVM_DEPTH);
+        if (error_log_ctx.nvm_record[record_index].code == code) break;
+    }
+    if (idx < error_log_ctx.nvm_number_of_records) {
+        // Only update occurrences counter and timestamp.
+        record_ptr = &(error_log_ctx.nvm_record[record_index]);
+        if ((record_ptr->number_of_occurrences) < ERROR_LOG_NUMBER_OF_OCCURRENCES_MAX) {
+            (record_ptr->number_of_occurrences)++;
+        }
+    }
+    else {
+        // Create new record (the oldest one is overwritten when the log is full).
+        record_index = error_log_ctx.nvm_write_index;
+        record_ptr = &(error_log_ctx.nvm_record[record_index]);
+        (record_ptr->code) = code;
+        (record_ptr->number_of_occurrences) = 1;
+        error_log_ctx.nvm_write_index = ((error_log_ctx.nvm_write_index + 1) % ERROR_LOG_NVM_DEPTH);
+        if (error_log_ctx.nvm_number_of_records < ERROR_LOG_NVM_DEPTH) {
+            error_log_ctx.nvm_number_of_records++;
+        }
+        // New records are written without rate limit so that they survive a watchdog reset.
+        error_log_ctx.nvm_written_mask &= ~(0b1 << record_index);
+        error_log_ctx.nvm_header_dirty_flag = 1;
+    }
+    (record_ptr->time_seconds) = time_seconds;
+    error_log_ctx.nvm_dirty_mask |= (0b1 << record_index);
+}
+
+/*******************************************************************/
+static void _ERROR_LOG_add(ERROR_code_t code, uint32_t time_seconds) {
+    // Update RAM log.
+    _ERROR_LOG_add_ram(code, time_seconds);
+    // Errors of the log itself are not stored in NVM, to avoid a feedback loop in case of NVM failure.
+    if ((code >= ERROR_BASE_ERROR_LOG) && (code < (ERROR_BASE_ERROR_LOG + ERROR_LOG_ERROR_BASE_LAST))) return;
+    // Update NVM log.
+    _ERROR_LOG_add_nvm(code, time_seconds);
+}
+
+/*** ERROR LOG functions ***/
+
+/*******************************************************************/
+ERROR_LOG_status_t ERROR_LOG_init(void) {
+    // Local variables.
+    ERROR_LOG_status_t status = ERROR_LOG_SUCCESS;
+    uint32_t nvm_word = 0;
+    uint8_t word_index = 0;
+    uint8_t idx = 0;
+    // Init context.
+    error_log_ctx.write_index = 0;
+    error_log_ctx.number_of_records = 0;
+    error_log_ctx.number_of_unread_records = 0;
+    error_log_ctx.nvm_write_index = 0;
+    error_log_ctx.nvm_number_of_records = 0;
+    error_log_ctx.nvm_dirty_mask = 0;
+    error_log_ctx.nvm_written_mask = 0;
+    error_log_ctx.nvm_header_dirty_flag = 0;
+    error_log_ctx.nvm_disable_flag = 0;
+    for (idx = 0; idx < ERROR_LOG_NVM_DEPTH; idx++) {
+        error_log_ctx.nvm_record_write_time_seconds[idx] = 0;
+    }
+    // Read NVM header.
+    status = _ERROR_LOG_read_nvm_word(ERROR_LOG_NVM_HEADER_WORD_INDEX, &nvm_word);
+    if (status != ERROR_LOG_SUCCESS) goto errors;
+    // Check header validity.
+    if ((((nvm_word >> 16) & 0x0000FFFF) != ERROR_LOG_NVM_HEADER_MAGIC) || (((nvm_word >> 0) & 0x000000FF) >= ERROR_LOG_NVM_DEPTH) || (((nvm_word >> 8) & 0x000000FF) > ERROR_LOG_NVM_DEPTH)) {
+        // Initialize empty log.
+        status = _ERROR_LOG_write_nvm_header();
+        goto errors;
+    }
+    error_log_ctx.nvm_write_index = (uint8_t) ((nvm_word >> 0) & 0x000000FF);
+    error_log_ctx.nvm_number_of_records = (uint8_t) ((nvm_word >> 8) & 0x000000FF);
+    // Load records.
+    for (idx = 0; idx < ERROR_LOG_NVM_DEPTH; idx++) {
+        word_index = (ERROR_LOG_NVM_RECORDS_WORD_INDEX + (idx * ERROR_LOG_NVM_RECORD_SIZE_WORDS));
+        status = _ERROR_LOG_read_nvm_word(word_index, &nvm_word);
+        if (status != ERROR_LOG_SUCCESS) goto errors;
+        error_log_ctx.nvm_record[idx].code = (ERROR_code_t) ((nvm_word >> 0) & 0x0000FFFF);
+        error_log_ctx.nvm_record[idx].number_of_occurrences = (uint16_t) ((nvm_word >> 16) & 0x0000FFFF);
+        status = _ERROR_LOG_read_nvm_word((word_index + 1), &(error_log_ctx.nvm_record[idx].time_seconds));
+        if (status != ERROR_LOG_SUCCESS) goto errors;
+    }
+errors:
+    // Keep the log in RAM only if the NVM is not available.
+    if (status != ERROR_LOG_SUCCESS) {
+        error_log_ctx.nvm_disable_flag = 1;
+    }
+    return status;
+}
+
+/*******************************************************************/
+ERROR_LOG_status_t ERROR_LOG_process(void) {
+    // Import pending codes.
+    ERROR_LOG_import_stack();
+    // Write modified records in NVM.
+    return _ERROR_LOG_flush_nvm(RTC_get_uptime_seconds());
+}
+
+/*******************************************************************/
+void ERROR_LOG_import_stack(void) {
+    // Local variables.
+    uint32_t uptime_seconds = RTC_get_uptime_seconds();
+#ifdef UHFM
+    ERROR_import_sigfox_stack();
+#endif
+    // Move all pending codes into the log.
+    while (ERROR_stack_is_empty() == 0) {
+        _ERROR_LOG_add(ERROR_stack_read(), uptime_seconds);
+    }
+}
+
+/*******************************************************************/
+ERROR_code_t ERROR_LOG_read(void) {
+    // Local variables.
+    ERROR_code_t code = SUCCESS;
+    // Check unread records.
+    if (error_log_ctx.number_of_unread_records != 0) {
+        code = error_log_ctx.record[(error_log_ctx.write_index + ERROR_LOG_RAM_DEPTH - error_log_ctx.number_of_unread_records) % ERROR_LOG_RAM_DEPTH].code;
+        error_log_ctx.number_of_unread_records--;
+    }
+    return code;
+}
+
+/*******************************************************************/
+uint8_t ERROR_LOG_is_empty(void) {
+    return ((error_log_ctx.number_of_unread_records == 0) ? 1 : 0);
+}
+
+/*******************************************************************/
+uint8_t ERROR_LOG_get_number_of_records(ERROR_LOG_source_t source) {
+    return ((source == ERROR_LOG_SOURCE_NVM) ? error_log_ctx.nvm_number_of_records : error_log_ctx.number_of_records);
+}
+
+/*******************************************************************/
+ERROR_LOG_status_t ERROR_LOG_get_record(ERROR_LOG_source_t source, uint8_t record_index, ERROR_LOG_record_t* record) {
+    // Local variables.
+    ERROR_LOG_status_t status = ERROR_LOG_SUCCESS;
+    // Check parameters.
+    if (record == NULL) {
+        status = ERROR_LOG_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (source >= ERROR_LOG_SOURCE_LAST) {
+        status = ERROR_LOG_ERROR_SOURCE;
+        goto errors;
+    }
+    if (record_index >= ERROR_LOG_get_number_of_records(source)) {
+        status = ERROR_LOG_ERROR_RECORD_INDEX;
+        goto errors;
+    }
+    // Read record starting from the most recent one.
+    if (source == ERROR_LOG_SOURCE_NVM) {
+        (*record) = error_log_ctx.nvm_record[(error_log_ctx.nvm_write_index + ERROR_LOG_NVM_DEPTH - 1 - record_index) % ERROR_LOG_NVM_DEPTH];
+    }
+    else {
+        (*record) = error_log_ctx.record[(error_log_ctx.write_index + ERROR_LOG_RAM_DEPTH - 1 - record_index) % ERROR_LOG_RAM_DEPTH];
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+ERROR_LOG_status_t ERROR_LOG_clear(void) {
+    // Reset RAM log.
+    error_log_ctx.write_index = 0;
+    error_log_ctx.number_of_records = 0;
+    error_log_ctx.number_of_unread_records = 0;
+    // Reset NVM log (header is written by the next process call).
+    error_log_ctx.nvm_write_index = 0;
+    error_log_ctx.nvm_number_of_records = 0;
+    error_log_ctx.nvm_dirty_mask = 0;
+    error_log_ctx.nvm_header_dirty_flag = 1;
+    return ERROR_LOG_SUCCESS;
+}
+
+#endif /* DSM_ERROR_LOG */
@@ -27,6 +27,8 @@ typedef enum {
     // Driver errors.
     GPS_SUCCESS = 0,
     GPS_ERROR_NULL_PARAMETER,
+    GPS_ERROR_STATE,
+    GPS_ERROR_ACQUISITION_TYPE,
     // Low level drivers errors.
     GPS_ERROR_BASE_NEOM8N = ERROR_BASE_STEP,
     GPS_ERROR_BASE_LED = (GPS_ERROR_BASE_NEOM8N + NEOM8X_ERROR_BASE_LAST),
@@ -36,6 +38,27 @@ typedef enum {
 
 #ifdef GPSM
 
+/*!******************************************************************
+ * \enum GPS_acquisition_type_t
+ * \brief GPS acquisition types.
+ *******************************************************************/
+typedef enum {
+    GPS_ACQUISITION_TYPE_TIME = 0,
+    GPS_ACQUISITION_TYPE_POSITION,
+    GPS_ACQUISITION_TYPE_LAST
+} GPS_acquisition_type_t;
+
+/*!******************************************************************
+ * \enum GPS_acquisition_state_t
+ * \brief GPS acquisition states.
+ *******************************************************************/
+typedef enum {
+    GPS_ACQUISITION_STATE_IDLE = 0,
+    GPS_ACQUISITION_STATE_RUNNING,
+    GPS_ACQUISITION_STATE_DONE,
+    GPS_ACQUISITION_STATE_LAST
+} GPS_acquisition_state_t;
+
 /*!******************************************************************
  * \enum GPS_acquisition_status_t
  * \brief GPS acquisition status.
@@ -85,26 +108,69 @@ GPS_status_t GPS_init(void);
 GPS_status_t GPS_de_init(void);
 
 /*!******************************************************************
- * \fn GPS_status_t GPS_get_time(GPS_time_t* gps_time, uint32_t timeout_seconds, uint32_t* acquisition_duration_seconds, GPS_acquisition_status_t* acquisition_status)
- * \brief Perform GPS position acquisition.
+ * \fn GPS_status_t GPS_start_acquisition(GPS_acquisition_type_t acquisition_type, uint32_t timeout_seconds)
+ * \brief Start GPS acquisition in background.
+ * \param[in]   acquisition_type: Data to acquire.
  * \param[in]   timeout_seconds: Fix timeout in seconds.
- * \param[out]  gps_time: Pointer to the GPS time if found.
- * \param[out]  acquisition_duration_seconds; Pointer to integer that will contain the GPS acquisition duration in seconds.
- * \param[out]  acquisition_success: Pointer to the acquisition success flag.
+ * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-GPS_status_t GPS_get_time(GPS_time_t* gps_time, uint32_t timeout_seconds, uint32_t* acquisition_duration_seconds, GPS_acquisition_status_t* acquisition_status);
+GPS_status_t GPS_start_acquisition(GPS_acquisition_type_t acquisition_type, uint32_t timeout_seconds);
 
 /*!******************************************************************
- * \fn GPS_status_t GPS_get_position(GPS_position_t* gps_position, uint32_t timeout_seconds, uint32_t* acquisition_duration_seconds, GPS_acquisition_status_t* acquisition_status)
- * \brief Perform GPS position acquisition.
- * \param[in]   timeout_seconds: Fix timeout in seconds.
- * \param[out]  gps_position: Pointer to the GPS position if found.
- * \param[out]  acquisition_duration_seconds; Pointer to integer that will contain the GPS acquisition duration in seconds.
- * \param[out]  acquisition_success: Pointer to the acquisition success flag.
+ * \fn GPS_status_t GPS_stop_acquisition(void)
+ * \brief Stop running GPS acquisition.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+GPS_status_t GPS_stop_acquisition(void);
+
+/*!******************************************************************
+ * \fn GPS_status_t GPS_process(void)
+ * \brief Process GPS acquisition (fix detection and timeout).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+GPS_status_t GPS_process(void);
+
+/*!******************************************************************
+ * \fn GPS_acquisition_state_t GPS_get_acquisition_state(void)
+ * \brief Get GPS acquisition state.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Current acquisition state.
+ *******************************************************************/
+GPS_acquisition_state_t GPS_get_acquisition_state(void);
+
+/*!******************************************************************
+ * \fn GPS_status_t GPS_get_acquisition_status(GPS_acquisition_status_t* acquisition_status, uint32_t* acquisition_duration_seconds)
+ * \brief Get last GPS acquisition result and release the DONE state.
+ * \param[in]   none
+ * \param[out]  acquisition_status: Pointer to the acquisition status.
+ * \param[out]  acquisition_duration_seconds: Pointer to the acquisition duration in seconds.
+ * \retval      Function execution status.
+ *******************************************************************/
+GPS_status_t GPS_get_acquisition_status(GPS_acquisition_status_t* acquisition_status, uint32_t* acquisition_duration_seconds);
+
+/*!******************************************************************
+ * \fn GPS_status_t GPS_get_time(GPS_time_t* gps_time)
+ * \brief Read GPS time of the last successful time acquisition.
+ * \param[in]   none
+ * \param[out]  gps_time: Pointer to the GPS time.
+ * \retval      Function execution status.
+ *******************************************************************/
+GPS_status_t GPS_get_time(GPS_time_t* gps_time);
+
+/*!******************************************************************
+ * \fn GPS_status_t GPS_get_position(GPS_position_t* gps_position)
+ * \brief Read GPS position of the last successful position acquisition.
+ * \param[in]   none
+ * \param[out]  gps_position: Pointer to the GPS position.
  * \retval      Function execution status.
  *******************************************************************/
-GPS_status_t GPS_get_position(GPS_position_t* gps_position, uint32_t timeout_seconds, uint32_t* acquisition_duration_seconds, GPS_acquisition_status_t* acquisition_status);
+GPS_status_t GPS_get_position(GPS_position_t* gps_position);
 
 /*!******************************************************************
  * \fn GPS_status_t GPS_set_backup_voltage(uint8_t state)
@@ -9,10 +9,9 @@
 
 #include "error.h"
 #include "error_base.h"
-#include "iwdg.h"
 #include "neom8x.h"
-#include "pwr.h"
 #include "rtc.h"
+#include "scheduler.h"
 #include "types.h"
 
 #ifdef GPSM
@@ -26,14 +25,27 @@
 /*******************************************************************/
 typedef struct {
     volatile uint8_t process_flag;
-    NEOM8X_acquisition_status_t acquisition_status;
+    GPS_acquisition_state_t state;
+    GPS_acquisition_type_t type;
+    NEOM8X_acquisition_t neom8x_acquisition;
+    NEOM8X_acquisition_status_t expected_acquisition_status;
+    volatile NEOM8X_acquisition_status_t acquisition_status;
+    uint32_t start_time_seconds;
+    uint32_t timeout_seconds;
+    uint32_t acquisition_duration_seconds;
 } GPS_context_t;
 
 /*** GPS local global variables ***/
 
 static GPS_context_t gps_ctx = {
     .process_flag = 0,
-    .acquisition_status = NEOM8X_ACQUISITION_STATUS_FAIL
+    .state = GPS_ACQUISITION_STATE_IDLE,
+    .type = GPS_ACQUISITION_TYPE_TIME,
+    .expected_acquisition_status = NEOM8X_ACQUISITION_STATUS_FOUND,
+    .acquisition_status = NEOM8X_ACQUISITION_STATUS_FAIL,
+    .start_time_seconds = 0,
+    .timeout_seconds = 0,
+    .acquisition_duration_seconds = 0
 };
 
 /*** GPS local functions ***/
@@ -42,6 +54,8 @@ static GPS_context_t gps_ctx = {
 static void _GPS_process_callback(void) {
     // Set local flag.
     gps_ctx.process_flag = 1;
+    // Wake-up node task.
+    SCHEDULER_post_event(SCHEDULER_TASK_NODE);
 }
 
 /*******************************************************************/
@@ -50,127 +64,209 @@ static void _GPS_completion_callback(NEOM8X_acquisition_status_t acquisition_sta
     gps_ctx.acquisition_status = acquisition_status;
 }
 
+/*** GPS functions ***/
+
 /*******************************************************************/
-static GPS_status_t _GPS_perform_acquisition(NEOM8X_gps_data_t gps_data, NEOM8X_acquisition_status_t expected_acquisition_status, uint32_t timeout_seconds, uint32_t* acquisition_duration_seconds) {
+GPS_status_t GPS_init(void) {
     // Local variables.
     GPS_status_t status = GPS_SUCCESS;
-    LED_status_t led_status = LED_SUCCESS;
-    NEOM8X_status_t neom8x_status;
-    NEOM8X_acquisition_t gps_acquisition;
-    uint32_t start_time = RTC_get_uptime_seconds();
+    NEOM8X_status_t neom8x_status = NEOM8X_SUCCESS;
+    // Init context.
+    gps_ctx.process_flag = 0;
+    gps_ctx.state = GPS_ACQUISITION_STATE_IDLE;
+    gps_ctx.acquisition_status = NEOM8X_ACQUISITION_STATUS_FAIL;
+    gps_ctx.acquisition_duration_seconds = 0;
+    // Init GPS module.
+    neom8x_status = NEOM8X_init();
+    NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+GPS_status_t GPS_de_init(void) {
+    // Local variables.
+    GPS_status_t status = GPS_SUCCESS;
+    NEOM8X_status_t neom8x_status = NEOM8X_SUCCESS;
+    // Stop running acquisition.
+    if (gps_ctx.state == GPS_ACQUISITION_STATE_RUNNING) {
+        NEOM8X_stop_acquisition();
+        gps_ctx.state = GPS_ACQUISITION_STATE_IDLE;
+    }
+    // Init GPS module.
+    neom8x_status = NEOM8X_de_init();
+    NEOM8X_stack_error(ERROR_BASE_GPS + GPS_ERROR_BASE_NEOM8N);
+    return status;
+}
+
+/*******************************************************************/
+GPS_status_t GPS_start_acquisition(GPS_acquisition_type_t acquisition_type, uint32_t timeout_seconds) {
+    // Local variables.
+    GPS_status_t status = GPS_SUCCESS;
+    NEOM8X_status_t neom8x_status = NEOM8X_SUCCESS;
+    // Check state.
+    if (gps_ctx.state == GPS_ACQUISITION_STATE_RUNNING) {
+        status = GPS_ERROR_STATE;
+        goto errors;
+    }
+    // Check acquisition type.
+    switch (acquisition_type) {
+    case GPS_ACQUISITION_TYPE_TIME:
+        gps_ctx.neom8x_acquisition.gps_data = NEOM8X_GPS_DATA_TIME;
+        gps_ctx.expected_acquisition_status = NEOM8X_ACQUISITION_STATUS_FOUND;
+        break;
+    case GPS_ACQUISITION_TYPE_POSITION:
+        gps_ctx.neom8x_acquisition.gps_data = NEOM8X_GPS_DATA_POSITION;
+        gps_ctx.expected_acquisition_status = NEOM8X_ACQUISITION_STATUS_STABLE;
+        break;
+    default:
+        status = GPS_ERROR_ACQUISITION_TYPE;
+        goto errors;
+    }
     // Reset data.
+    gps_ctx.type = acquisition_type;
+    gps_ctx.process_flag = 0;
     gps_ctx.acquisition_status = NEOM8X_ACQUISITION_STATUS_FAIL;
-    (*acquisition_duration_seconds) = 0;
+    gps_ctx.start_time_seconds = RTC_get_uptime_seconds();
+    gps_ctx.timeout_seconds = timeout_seconds;
+    gps_ctx.acquisition_duration_seconds = 0;
     // Configure GPS acquisition.
-    gps_acquisition.gps_data = gps_data;
-    gps_acquisition.completion_callback = &_GPS_completion_callback;
-    gps_acquisition.process_callback = &_GPS_process_callback;
+    gps_ctx.neom8x_acquisition.completion_callback = &_GPS_completion_callback;
+    gps_ctx.neom8x_acquisition.process_callback = &_GPS_process_callback;
     // Start acquisition.
-    neom8x_status = NEOM8X_start_acquisition(&gps_acquisition);
-    NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
-    // Processing loop.
-    while (RTC_get_uptime_seconds() < (start_time + timeout_seconds)) {
-        // Enter sleep mode.
-        IWDG_reload();
-        PWR_enter_sleep_mode(PWR_SLEEP_MODE_NORMAL);
-        // Update acquisition duration.
-        (*acquisition_duration_seconds) = (RTC_get_uptime_seconds() - start_time);
-        // Check flag.
-        if (gps_ctx.process_flag != 0) {
-            // Process driver.
-            neom8x_status = NEOM8X_process();
-            NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
-            // Blink LED.
-            led_status = LED_start_single_blink(GPS_ACQUISITION_LED_BLINK_DURATION_US, LED_COLOR_YELLOW);
-            LED_exit_error(GPS_ERROR_BASE_LED);
-        }
-        // Check acquisition status.
-        if (gps_ctx.acquisition_status == expected_acquisition_status) break;
-    }
-    neom8x_status = NEOM8X_stop_acquisition();
+    neom8x_status = NEOM8X_start_acquisition(&(gps_ctx.neom8x_acquisition));
     NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
+    // Update state.
+    gps_ctx.state = GPS_ACQUISITION_STATE_RUNNING;
+    SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, (gps_ctx.start_time_seconds + gps_ctx.timeout_seconds));
+    return status;
 errors:
     NEOM8X_stop_acquisition();
     return status;
 }
 
-/*** GPS functions ***/
-
 /*******************************************************************/
-GPS_status_t GPS_init(void) {
+GPS_status_t GPS_stop_acquisition(void) {
     // Local variables.
     GPS_status_t status = GPS_SUCCESS;
     NEOM8X_status_t neom8x_status = NEOM8X_SUCCESS;
-    // Init GPS module.
-    neom8x_status = NEOM8X_init();
+    // Check state.
+    if (gps_ctx.state != GPS_ACQUISITION_STATE_RUNNING) goto errors;
+    // Update state.
+    gps_ctx.state = GPS_ACQUISITION_STATE_DONE;
+    // Stop acquisition.
+    neom8x_status = NEOM8X_stop_acquisition();
     NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
 errors:
     return status;
 }
 
 /*******************************************************************/
-GPS_status_t GPS_de_init(void) {
+GPS_status_t GPS_process(void) {
     // Local variables.
     GPS_status_t status = GPS_SUCCESS;
     NEOM8X_status_t neom8x_status = NEOM8X_SUCCESS;
-    // Init GPS module.
-    neom8x_status = NEOM8X_de_init();
-    NEOM8X_stack_error(ERROR_BASE_GPS + GPS_ERROR_BASE_NEOM8N);
+    LED_status_t led_status = LED_SUCCESS;
+    uint32_t end_time_seconds = 0;
+    // Check state.
+    if (gps_ctx.state != GPS_ACQUISITION_STATE_RUNNING) goto errors;
+    // Update acquisition duration.
+    gps_ctx.acquisition_duration_seconds = (RTC_get_uptime_seconds() - gps_ctx.start_time_seconds);
+    // Check flag.
+    if (gps_ctx.process_flag != 0) {
+        // Clear flag.
+        gps_ctx.process_flag = 0;
+        // Process driver.
+        neom8x_status = NEOM8X_process();
+        NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
+        // Blink LED.
+        led_status = LED_start_single_blink(GPS_ACQUISITION_LED_BLINK_DURATION_US, LED_COLOR_YELLOW);
+        LED_exit_error(GPS_ERROR_BASE_LED);
+    }
+    // Check acquisition status and timeout.
+    if ((gps_ctx.acquisition_status == gps_ctx.expected_acquisition_status) || (gps_ctx.acquisition_duration_seconds >= gps_ctx.timeout_seconds)) {
+        status = GPS_stop_acquisition();
+        if (status != GPS_SUCCESS) goto errors;
+    }
+    else {
+        // Register timeout.
+        end_time_seconds = (gps_ctx.start_time_seconds + gps_ctx.timeout_seconds);
+        SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, end_time_seconds);
+    }
+    return status;
+errors:
+    if (gps_ctx.state == GPS_ACQUISITION_STATE_RUNNING) {
+        GPS_stop_acquisition();
+    }
     return status;
 }
 
 /*******************************************************************/
-GPS_status_t GPS_get_time(GPS_time_t* gps_time, uint32_t timeout_seconds, uint32_t* acquisition_duration_seconds, GPS_acquisition_status_t* acquisition_status) {
+GPS_acquisition_state_t GPS_get_acquisition_state(void) {
+    return (gps_ctx.state);
+}
+
+/*******************************************************************/
+GPS_status_t GPS_get_acquisition_status(GPS_acquisition_status_t* acquisition_status, uint32_t* acquisition_duration_seconds) {
     // Local variables.
     GPS_status_t status = GPS_SUCCESS;
-    NEOM8X_status_t neom8x_status = NEOM8X_SUCCESS;
     // Check parameters.
-    if ((acquisition_status == NULL) || (acquisition_status == NULL)) {
+    if ((acquisition_status == NULL) || (acquisition_duration_seconds == NULL)) {
         status = GPS_ERROR_NULL_PARAMETER;
         goto errors;
     }
-    // Reset output data.
-    (*acquisition_duration_seconds) = 0;
-    (*acquisition_status) = GPS_ACQUISITION_ERROR_TIMEOUT;
-    // Perform time acquisition.
-    status = _GPS_perform_acquisition(NEOM8X_GPS_DATA_TIME, NEOM8X_ACQUISITION_STATUS_FOUND, timeout_seconds, acquisition_duration_seconds);
-    if (status != GPS_SUCCESS) goto errors;
-    // Check status.
-    if (gps_ctx.acquisition_status != NEOM8X_ACQUISITION_STATUS_FAIL) {
-        // Read data.
-        neom8x_status = NEOM8X_get_time(gps_time);
-        NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
-        // Update status.
-        (*acquisition_status) = GPS_ACQUISITION_SUCCESS;
+    // Read status.
+    // Note: a position which has been found but is not stable yet at timeout is still valid.
+    (*acquisition_status) = (gps_ctx.acquisition_status != NEOM8X_ACQUISITION_STATUS_FAIL) ? GPS_ACQUISITION_SUCCESS : GPS_ACQUISITION_ERROR_TIMEOUT;
+    (*acquisition_duration_seconds) = gps_ctx.acquisition_duration_seconds;
+    // Result has been read.
+    if (gps_ctx.state == GPS_ACQUISITION_STATE_DONE) {
+        gps_ctx.state = GPS_ACQUISITION_STATE_IDLE;
     }
 errors:
     return status;
 }
 
 /*******************************************************************/
-GPS_status_t GPS_get_position(GPS_position_t* gps_position, uint32_t timeout_seconds, uint32_t* acquisition_duration_seconds, GPS_acquisition_status_t* acquisition_status) {
+GPS_status_t GPS_get_time(GPS_time_t* gps_time) {
     // Local variables.
     GPS_status_t status = GPS_SUCCESS;
     NEOM8X_status_t neom8x_status = NEOM8X_SUCCESS;
-    // Check parameters.
-    if ((acquisition_duration_seconds == NULL) || (acquisition_status == NULL)) {
+    // Check parameter.
+    if (gps_time == NULL) {
         status = GPS_ERROR_NULL_PARAMETER;
         goto errors;
     }
-    // Reset output data.
-    (*acquisition_duration_seconds) = 0;
-    (*acquisition_status) = GPS_ACQUISITION_ERROR_TIMEOUT;
-    // Perform position acquisition.
-    status = _GPS_perform_acquisition(NEOM8X_GPS_DATA_POSITION, NEOM8X_ACQUISITION_STATUS_STABLE, timeout_seconds, acquisition_duration_seconds);
-    if (status != GPS_SUCCESS) goto errors;
-    // Check status.
-    if (gps_ctx.acquisition_status != NEOM8X_ACQUISITION_STATUS_FAIL) {
-        // Read data.
-        neom8x_status = NEOM8X_get_position(gps_position);
-        NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
-        // Update status.
-        (*acquisition_status) = GPS_ACQUISITION_SUCCESS;
+    // Check last acquisition.
+    if ((gps_ctx.state == GPS_ACQUISITION_STATE_RUNNING) || (gps_ctx.type != GPS_ACQUISITION_TYPE_TIME) || (gps_ctx.acquisition_status == NEOM8X_ACQUISITION_STATUS_FAIL)) {
+        status = GPS_ERROR_STATE;
+        goto errors;
     }
+    // Read data.
+    neom8x_status = NEOM8X_get_time(gps_time);
+    NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+GPS_status_t GPS_get_position(GPS_position_t* gps_position) {
+    // Local variables.
+    GPS_status_t status = GPS_SUCCESS;
+    NEOM8X_status_t neom8x_status = NEOM8X_SUCCESS;
+    // Check parameter.
+    if (gps_position == NULL) {
+        status = GPS_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Check last acquisition.
+    if ((gps_ctx.state == GPS_ACQUISITION_STATE_RUNNING) || (gps_ctx.type != GPS_ACQUISITION_TYPE_POSITION) || (gps_ctx.acquisition_status == NEOM8X_ACQUISITION_STATUS_FAIL)) {
+        status = GPS_ERROR_STATE;
+        goto errors;
+    }
+    // Read data.
+    neom8x_status = NEOM8X_get_position(gps_position);
+    NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
 errors:
     return status;
 }
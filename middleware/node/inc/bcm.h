@@ -9,6 +9,7 @@
 #define __BCM_H__
 
 #include "bcm_registers.h"
+#include "monitor.h"
 #include "node_status.h"
 #include "una.h"
 
@@ -26,6 +27,11 @@
 #define NODE_PROCESS_REGISTER       BCM_process_register
 #define NODE_REFRESH_REGISTER       BCM_refresh_register
 #define NODE_MTRG_CALLBACK          BCM_mtrg_callback
+#define NODE_MONITOR_CONFIGURATION  BCM_MONITOR_CONFIGURATION
+
+/*** BCM global variables ***/
+
+extern const MONITOR_configuration_t BCM_MONITOR_CONFIGURATION;
 
 /*** BCM functions ***/
 
@@ -86,15 +92,6 @@ NODE_status_t BCM_process_register(uint8_t reg_addr, uint32_t reg_mask);
  *******************************************************************/
 NODE_status_t BCM_mtrg_callback(void);
 
-/*!******************************************************************
- * \fn NODE_status_t BCM_low_voltage_detector_process(void)
- * \brief BCM low voltage detector process.
- * \param[in]   none
- * \param[out]  none
- * \retval      Function execution status.
- *******************************************************************/
-NODE_status_t BCM_low_voltage_detector_process(void);
-
 #ifndef BCM_CHARGE_CONTROL_FORCED_HARDWARE
 /*!******************************************************************
  * \fn NODE_status_t BCM_charge_process(void)
@@ -9,6 +9,7 @@
 #define __BPSM_H__
 
 #include "bpsm_registers.h"
+#include "monitor.h"
 #include "node_status.h"
 #include "una.h"
 
@@ -26,6 +27,11 @@
 #define NODE_PROCESS_REGISTER       BPSM_process_register
 #define NODE_REFRESH_REGISTER       BPSM_refresh_register
 #define NODE_MTRG_CALLBACK          BPSM_mtrg_callback
+#define NODE_MONITOR_CONFIGURATION  BPSM_MONITOR_CONFIGURATION
+
+/*** BPSM global variables ***/
+
+extern const MONITOR_configuration_t BPSM_MONITOR_CONFIGURATION;
 
 /*** BPSM functions ***/
 
@@ -86,15 +92,6 @@ NODE_status_t BPSM_process_register(uint8_t reg_addr, uint32_t reg_mask);
  *******************************************************************/
 NODE_status_t BPSM_mtrg_callback(void);
 
-/*!******************************************************************
- * \fn NODE_status_t BPSM_low_voltage_detector_process(void)
- * \brief BPSM low voltage detector process.
- * \param[in]   none
- * \param[out]  none
- * \retval      Function execution status.
- *******************************************************************/
-NODE_status_t BPSM_low_voltage_detector_process(void);
-
 #ifndef BPSM_CHARGE_CONTROL_FORCED_HARDWARE
 /*!******************************************************************
  * \fn NODE_status_t BPSM_charge_process(void)
@@ -0,0 +1,84 @@
+/*
+ * gauge.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __GAUGE_H__
+#define __GAUGE_H__
+
+#include "node_status.h"
+#include "types.h"
+
+/*** GAUGE macros ***/
+
+#define GAUGE_RUNTIME_UNKNOWN   0xFFFFFFFF
+
+/*** GAUGE structures ***/
+
+/*!******************************************************************
+ * \struct GAUGE_ocv_point_t
+ * \brief Point of the storage element rest voltage curve.
+ *******************************************************************/
+typedef struct {
+    int32_t voltage_mv;
+    uint8_t soc_percent;
+} GAUGE_ocv_point_t;
+
+/*!******************************************************************
+ * \struct GAUGE_configuration_t
+ * \brief Storage element characteristics.
+ *******************************************************************/
+typedef struct {
+    uint32_t capacity_mah;
+    const GAUGE_ocv_point_t* ocv_table;
+    uint8_t ocv_table_size;
+    int32_t rest_current_ua;
+    uint32_t rest_duration_seconds;
+} GAUGE_configuration_t;
+
+/*!******************************************************************
+ * \struct GAUGE_data_t
+ * \brief Estimated storage element state.
+ *******************************************************************/
+typedef struct {
+    uint8_t soc_percent;
+    // Integrated charge current.
+    uint32_t charged_mah;
+    // Integrated estimated discharge current.
+    uint32_t discharged_mah;
+    uint32_t runtime_minutes;
+} GAUGE_data_t;
+
+/*** GAUGE functions ***/
+
+/*!******************************************************************
+ * \fn void GAUGE_init(const GAUGE_configuration_t* configuration)
+ * \brief Init state of charge estimator.
+ * \param[in]   configuration: Pointer to the storage element characteristics.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void GAUGE_init(const GAUGE_configuration_t* configuration);
+
+/*!******************************************************************
+ * \fn NODE_status_t GAUGE_update(int32_t storage_voltage_mv, int32_t charge_current_ua)
+ * \brief Integrate the charge and estimated discharge currents since the last update and recalibrate on the rest voltage.
+ * \param[in]   storage_voltage_mv: Storage element voltage in mV.
+ * \param[in]   charge_current_ua: Charge current in uA (0 if not measured).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t GAUGE_update(int32_t storage_voltage_mv, int32_t charge_current_ua);
+
+/*!******************************************************************
+ * \fn NODE_status_t GAUGE_get_data(GAUGE_data_t* gauge_data)
+ * \brief Get estimated storage element state.
+ * \param[in]   none
+ * \param[out]  gauge_data: Pointer to the estimated state.
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t GAUGE_get_data(GAUGE_data_t* gauge_data);
+
+#endif /* __GAUGE_H__ */
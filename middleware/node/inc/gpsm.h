@@ -77,6 +77,15 @@ NODE_status_t GPSM_secure_register(uint8_t reg_addr, uint32_t new_reg_value, uin
  *******************************************************************/
 NODE_status_t GPSM_process_register(uint8_t reg_addr, uint32_t reg_mask);
 
+/*!******************************************************************
+ * \fn NODE_status_t GPSM_process(void)
+ * \brief Process GPSM background acquisitions.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t GPSM_process(void);
+
 /*!******************************************************************
  * \fn NODE_status_t GPSM_mtrg_callback(void)
  * \brief GPSM measurements callback.
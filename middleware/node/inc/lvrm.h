@@ -8,7 +8,9 @@
 #ifndef __LVRM_H__
 #define __LVRM_H__
 
+#include "dsm_flags.h"
 #include "lvrm_registers.h"
+#include "monitor.h"
 #include "node_status.h"
 #include "una.h"
 
@@ -26,6 +28,15 @@
 #define NODE_PROCESS_REGISTER       LVRM_process_register
 #define NODE_REFRESH_REGISTER       LVRM_refresh_register
 #define NODE_MTRG_CALLBACK          LVRM_mtrg_callback
+#ifdef LVRM_MODE_BMS
+#define NODE_MONITOR_CONFIGURATION  LVRM_MONITOR_CONFIGURATION
+#endif
+
+/*** LVRM global variables ***/
+
+#ifdef LVRM_MODE_BMS
+extern const MONITOR_configuration_t LVRM_MONITOR_CONFIGURATION;
+#endif
 
 /*** LVRM functions ***/
 
@@ -86,17 +97,6 @@ NODE_status_t LVRM_process_register(uint8_t reg_addr, uint32_t reg_mask);
  *******************************************************************/
 NODE_status_t LVRM_mtrg_callback(void);
 
-#ifdef LVRM_MODE_BMS
-/*!******************************************************************
- * \fn NODE_status_t LVRM_bms_process(UNA_node_address_t lvrm_node_addr)
- * \brief BMS function.
- * \param[in]   none
- * \param[out]  none
- * \retval      Function execution status.
- *******************************************************************/
-NODE_status_t LVRM_bms_process(void);
-#endif
-
 #endif /* LVRM */
 
 #endif /* __LVRM_H__ */
@@ -0,0 +1,89 @@
+/*
+ * monitor.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __MONITOR_H__
+#define __MONITOR_H__
+
+#include "analog.h"
+#include "node_status.h"
+#include "power.h"
+#include "types.h"
+
+/*** MONITOR structures ***/
+
+/*!******************************************************************
+ * \enum MONITOR_level_t
+ * \brief Hysteresis output levels.
+ *******************************************************************/
+typedef enum {
+    MONITOR_LEVEL_LOW = 0,
+    MONITOR_LEVEL_HIGH,
+    MONITOR_LEVEL_LAST
+} MONITOR_level_t;
+
+/*!******************************************************************
+ * \fn MONITOR_hysteresis_cb_t
+ * \brief Called when the measured value crosses one of the thresholds.
+ *******************************************************************/
+typedef NODE_status_t (*MONITOR_hysteresis_cb_t)(MONITOR_level_t level);
+
+/*!******************************************************************
+ * \fn MONITOR_completion_cb_t
+ * \brief Called at the end of each measurement period.
+ *******************************************************************/
+typedef NODE_status_t (*MONITOR_completion_cb_t)(void);
+
+/*!******************************************************************
+ * \struct MONITOR_hysteresis_t
+ * \brief Hysteresis rule applied on a converted channel.
+ *******************************************************************/
+typedef struct {
+    uint8_t channel_index;
+    uint8_t threshold_reg_addr;
+    uint32_t threshold_low_mask;
+    uint32_t threshold_high_mask;
+    uint8_t flag_reg_addr;
+    uint32_t flag_mask;
+    MONITOR_hysteresis_cb_t callback;
+} MONITOR_hysteresis_t;
+
+/*!******************************************************************
+ * \struct MONITOR_configuration_t
+ * \brief Board measurement configuration.
+ *******************************************************************/
+typedef struct {
+    POWER_requester_id_t power_requester_id;
+    uint32_t period_seconds;
+    const ANALOG_channel_t* channels;
+    uint8_t number_of_channels;
+    int32_t* data;
+    const MONITOR_hysteresis_t* hysteresis;
+    uint8_t number_of_hysteresis;
+    MONITOR_completion_cb_t completion_callback;
+} MONITOR_configuration_t;
+
+/*** MONITOR functions ***/
+
+/*!******************************************************************
+ * \fn void MONITOR_init(const MONITOR_configuration_t* configuration)
+ * \brief Init periodic measurement service.
+ * \param[in]   configuration: Pointer to the board measurement configuration.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void MONITOR_init(const MONITOR_configuration_t* configuration);
+
+/*!******************************************************************
+ * \fn NODE_status_t MONITOR_process(void)
+ * \brief Convert all channels in a single analog power-up and apply the hysteresis rules when the period is reached.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t MONITOR_process(void);
+
+#endif /* __MONITOR_H__ */
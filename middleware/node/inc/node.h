@@ -84,6 +84,15 @@ NODE_state_t NODE_get_state(void);
  *******************************************************************/
 NODE_status_t NODE_write_register(uint8_t reg_addr, uint32_t reg_value, uint32_t reg_mask);
 
+/*!******************************************************************
+ * \fn NODE_status_t NODE_commit_registers(void)
+ * \brief Store all modified NVM registers without waiting for the idle delay.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_commit_registers(void);
+
 /*!******************************************************************
  * \fn NODE_status_t NODE_read_register(uint8_t reg_addr, uint32_t* reg_value)
  * \brief Read node register.
@@ -42,6 +42,7 @@ typedef enum {
     NODE_ERROR_SIGFOX_MCU_API,
     NODE_ERROR_SIGFOX_RF_API,
     NODE_ERROR_SIGFOX_EP_API,
+    NODE_ERROR_MONITOR_CHANNEL_INDEX,
     // Low level drivers errors.
     NODE_ERROR_BASE_NVM = ERROR_BASE_STEP,
     NODE_ERROR_BASE_LPTIM = (NODE_ERROR_BASE_NVM + NVM_ERROR_BASE_LAST),
@@ -9,6 +9,7 @@
 #define __UHFM_H__
 
 #include "adc.h"
+#include "dsm_flags.h"
 #include "node_status.h"
 #include "uhfm_registers.h"
 #include "una.h"
@@ -28,6 +29,28 @@
 #define NODE_REFRESH_REGISTER       UHFM_refresh_register
 #define NODE_MTRG_CALLBACK          UHFM_mtrg_callback
 
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+#define UHFM_UPLINK_QUEUE_ID_NONE   (-1)
+#endif
+
+/*** UHFM structures ***/
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*!******************************************************************
+ * \struct UHFM_uplink_queue_status_t
+ * \brief UHFM uplink queue status.
+ *******************************************************************/
+typedef struct {
+    uint8_t depth;
+    uint32_t drop_count;
+    uint32_t duplicate_count;
+    // Identifier of the entry created (or matched) by the last STRG request.
+    int32_t last_queued_id;
+    // Identifier of the entry which wrote the current message status and DL payload registers.
+    int32_t last_sent_id;
+} UHFM_uplink_queue_status_t;
+#endif
+
 /*** UHFM functions ***/
 
 /*!******************************************************************
@@ -78,6 +101,26 @@ NODE_status_t UHFM_secure_register(uint8_t reg_addr, uint32_t new_reg_value, uin
  *******************************************************************/
 NODE_status_t UHFM_process_register(uint8_t reg_addr, uint32_t reg_mask);
 
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*!******************************************************************
+ * \fn NODE_status_t UHFM_process(void)
+ * \brief Send the queued Sigfox messages (blocking).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t UHFM_process(void);
+
+/*!******************************************************************
+ * \fn NODE_status_t UHFM_get_uplink_queue_status(UHFM_uplink_queue_status_t* queue_status)
+ * \brief Get the uplink queue depth, the number of dropped and suppressed messages since boot and the last entries identifiers.
+ * \param[in]   none
+ * \param[out]  queue_status: Pointer to the queue status.
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t UHFM_get_uplink_queue_status(UHFM_uplink_queue_status_t* queue_status);
+#endif
+
 /*!******************************************************************
  * \fn NODE_status_t UHFM_mtrg_callback(void)
  * \brief UHFM measurements callback.
@@ -5,6 +5,8 @@
  *      Author: Ludo
  */
 
+#include "cli_flags.h"
+#include "dsm_flags.h"
 #include "lptim.h"
 #include "terminal_instance.h"
 
@@ -32,7 +34,9 @@
 
 #ifdef UNA_AT_MODE_SLAVE
 
-//#define UNA_AT_CUSTOM_COMMANDS
+#ifdef CLI_CUSTOM_COMMANDS
+#define UNA_AT_CUSTOM_COMMANDS
+#endif
 
 #endif /* UNA_AT_MODE_SLAVE */
 
@@ -14,11 +14,14 @@
 #include "dsm_flags.h"
 #include "dsm_flags_slave.h"
 #include "error.h"
+#include "gauge.h"
 #include "load.h"
+#include "monitor.h"
 #include "node_register.h"
 #include "node_status.h"
 #include "swreg.h"
 #include "rtc.h"
+#include "scheduler.h"
 #include "types.h"
 #include "una.h"
 
@@ -35,6 +38,11 @@
 #define BCM_XVF_STORAGE_VOLTAGE_TH_MV_MAX           60000
 #define BCM_XVF_UPDATE_PERIOD_SECONDS               5
 
+#ifdef BCM_STORAGE_CAPACITY_MAH
+#define BCM_GAUGE_REST_CURRENT_UA                   10000
+#define BCM_GAUGE_REST_DURATION_SECONDS             1800
+#endif
+
 #ifdef BCM_CHARGE_CONTROL_FORCED_HARDWARE
 #define BCM_FLAG_CCFH                               0b1
 #else
@@ -58,15 +66,23 @@
 
 /*** BCM local structures ***/
 
+/*******************************************************************/
+typedef enum {
+    BCM_MONITOR_CHANNEL_STORAGE_VOLTAGE = 0,
+    BCM_MONITOR_CHANNEL_CHARGE_CURRENT,
+#ifndef BCM_CHARGE_CONTROL_FORCED_HARDWARE
+    BCM_MONITOR_CHANNEL_SOURCE_VOLTAGE,
+#endif
+    BCM_MONITOR_CHANNEL_LAST
+} BCM_monitor_channel_t;
+
 /*******************************************************************/
 typedef struct {
     UNA_bit_representation_t charge_control_state;
     UNA_bit_representation_t backup_control_state;
-    uint32_t xvf_update_next_time_seconds;
-    int32_t charge_current_ua;
+    int32_t monitor_data[BCM_MONITOR_CHANNEL_LAST];
     int32_t charge_current_max_ua;
 #ifndef BCM_CHARGE_CONTROL_FORCED_HARDWARE
-    int32_t source_voltage_mv;
     uint32_t charge_toggle_previous_time_seconds;
     uint32_t charge_toggle_next_time_seconds;
 #endif
@@ -77,32 +93,101 @@ typedef struct {
 static BCM_context_t bcm_ctx = {
     .charge_control_state = UNA_BIT_ERROR,
     .backup_control_state = UNA_BIT_ERROR,
-    .charge_current_ua = 0,
     .charge_current_max_ua = 0,
-    .xvf_update_next_time_seconds = 0,
 #ifndef BCM_CHARGE_CONTROL_FORCED_HARDWARE
-    .source_voltage_mv = 0,
     .charge_toggle_previous_time_seconds = 0,
     .charge_toggle_next_time_seconds = 0,
 #endif
 };
 
+#ifdef BCM_STORAGE_CAPACITY_MAH
+// 12V lead-acid battery rest voltage (the gauge must only be enabled with this storage element).
+static const GAUGE_ocv_point_t BCM_GAUGE_OCV_TABLE[] = {
+    { 10500, 0 },
+    { 11510, 10 },
+    { 11660, 20 },
+    { 11810, 30 },
+    { 11960, 40 },
+    { 12100, 50 },
+    { 12240, 60 },
+    { 12370, 70 },
+    { 12500, 80 },
+    { 12620, 90 },
+    { 12730, 100 }
+};
+
+static const GAUGE_configuration_t BCM_GAUGE_CONFIGURATION = {
+    .capacity_mah = BCM_STORAGE_CAPACITY_MAH,
+    .ocv_table = BCM_GAUGE_OCV_TABLE,
+    .ocv_table_size = (sizeof(BCM_GAUGE_OCV_TABLE) / sizeof(GAUGE_ocv_point_t)),
+    .rest_current_ua = BCM_GAUGE_REST_CURRENT_UA,
+    .rest_duration_seconds = BCM_GAUGE_REST_DURATION_SECONDS
+};
+#endif
+
+static const ANALOG_channel_t BCM_MONITOR_CHANNEL[BCM_MONITOR_CHANNEL_LAST] = {
+    ANALOG_CHANNEL_STORAGE_VOLTAGE_MV,
+    ANALOG_CHANNEL_CHARGE_CURRENT_UA,
+#ifndef BCM_CHARGE_CONTROL_FORCED_HARDWARE
+    ANALOG_CHANNEL_SOURCE_VOLTAGE_MV,
+#endif
+};
+
+static const MONITOR_hysteresis_t BCM_MONITOR_HYSTERESIS[] = {
+    { BCM_MONITOR_CHANNEL_STORAGE_VOLTAGE, BCM_REGISTER_ADDRESS_CONFIGURATION_1, BCM_REGISTER_CONFIGURATION_1_MASK_LVF_STORAGE_VOLTAGE_THL, BCM_REGISTER_CONFIGURATION_1_MASK_LVF_STORAGE_VOLTAGE_THH, BCM_REGISTER_ADDRESS_STATUS_1, BCM_REGISTER_STATUS_1_MASK_LVF, NULL },
+    { BCM_MONITOR_CHANNEL_STORAGE_VOLTAGE, BCM_REGISTER_ADDRESS_CONFIGURATION_2, BCM_REGISTER_CONFIGURATION_2_MASK_CVF_STORAGE_VOLTAGE_THL, BCM_REGISTER_CONFIGURATION_2_MASK_CVF_STORAGE_VOLTAGE_THH, BCM_REGISTER_ADDRESS_STATUS_1, BCM_REGISTER_STATUS_1_MASK_CVF, NULL }
+};
+
+/*** BCM local functions ***/
+
+/*******************************************************************/
+static NODE_status_t _BCM_monitor_completion_callback(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    // Update maximum charge current.
+    if (bcm_ctx.monitor_data[BCM_MONITOR_CHANNEL_CHARGE_CURRENT] > bcm_ctx.charge_current_max_ua) {
+        bcm_ctx.charge_current_max_ua = bcm_ctx.monitor_data[BCM_MONITOR_CHANNEL_CHARGE_CURRENT];
+    }
+#ifdef BCM_STORAGE_CAPACITY_MAH
+    // Update state of charge.
+    status = GAUGE_update(bcm_ctx.monitor_data[BCM_MONITOR_CHANNEL_STORAGE_VOLTAGE], bcm_ctx.monitor_data[BCM_MONITOR_CHANNEL_CHARGE_CURRENT]);
+#endif
+    return status;
+}
+
+/*** BCM global variables ***/
+
+const MONITOR_configuration_t BCM_MONITOR_CONFIGURATION = {
+    .power_requester_id = POWER_REQUESTER_ID_BCM,
+    .period_seconds = BCM_XVF_UPDATE_PERIOD_SECONDS,
+    .channels = BCM_MONITOR_CHANNEL,
+    .number_of_channels = BCM_MONITOR_CHANNEL_LAST,
+    .data = bcm_ctx.monitor_data,
+    .hysteresis = BCM_MONITOR_HYSTERESIS,
+    .number_of_hysteresis = (sizeof(BCM_MONITOR_HYSTERESIS) / sizeof(MONITOR_hysteresis_t)),
+    .completion_callback = &_BCM_monitor_completion_callback
+};
+
 /*** BCM functions ***/
 
 /*******************************************************************/
 NODE_status_t BCM_init(void) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
+    uint8_t idx = 0;
     // Init context.
     bcm_ctx.charge_control_state = UNA_BIT_ERROR;
     bcm_ctx.backup_control_state = UNA_BIT_ERROR;
-    bcm_ctx.charge_current_ua = 0;
+    for (idx = 0; idx < BCM_MONITOR_CHANNEL_LAST; idx++) {
+        bcm_ctx.monitor_data[idx] = 0;
+    }
     bcm_ctx.charge_current_max_ua = 0;
-    bcm_ctx.xvf_update_next_time_seconds = 0;
 #ifndef BCM_CHARGE_CONTROL_FORCED_HARDWARE
-    bcm_ctx.source_voltage_mv = 0;
     bcm_ctx.charge_toggle_previous_time_seconds = 0;
     bcm_ctx.charge_toggle_next_time_seconds = 0;
+#endif
+#ifdef BCM_STORAGE_CAPACITY_MAH
+    GAUGE_init(&BCM_GAUGE_CONFIGURATION);
 #endif
     return status;
 }
@@ -154,7 +239,7 @@ void BCM_refresh_register(uint8_t reg_addr) {
         chrgst1 = UNA_BIT_FORCED_HARDWARE;
 #else
         // Check current.
-        if (bcm_ctx.charge_current_ua > 0) {
+        if (bcm_ctx.monitor_data[BCM_MONITOR_CHANNEL_CHARGE_CURRENT] > 0) {
             // Read pins.
             chrgst0 = ((LOAD_get_charge_status() >> 0) & 0x01);
             chrgst1 = ((LOAD_get_charge_status() >> 1) & 0x01);
@@ -377,57 +462,6 @@ errors:
     return status;
 }
 
-/*******************************************************************/
-NODE_status_t BCM_low_voltage_detector_process(void) {
-    // Local variables.
-    NODE_status_t status = NODE_SUCCESS;
-    ANALOG_status_t analog_status = ANALOG_SUCCESS;
-    uint32_t uptime_seconds = RTC_get_uptime_seconds();
-    uint32_t* reg_config_1_ptr = &(NODE_RAM_REGISTER[BCM_REGISTER_ADDRESS_CONFIGURATION_1]);
-    uint32_t* reg_config_2_ptr = &(NODE_RAM_REGISTER[BCM_REGISTER_ADDRESS_CONFIGURATION_2]);
-    uint32_t* reg_status_1_ptr = &(NODE_RAM_REGISTER[BCM_REGISTER_ADDRESS_STATUS_1]);
-    int32_t storage_voltage_mv = 0;
-    uint32_t unused_mask = 0;
-    // Check period.
-    if (uptime_seconds >= bcm_ctx.xvf_update_next_time_seconds) {
-        // Update next time.
-        bcm_ctx.xvf_update_next_time_seconds = uptime_seconds + BCM_XVF_UPDATE_PERIOD_SECONDS;
-        // Turn analog front-end on.
-        POWER_enable(POWER_REQUESTER_ID_BCM, POWER_DOMAIN_ANALOG, LPTIM_DELAY_MODE_ACTIVE);
-        // Read battery voltage.
-        analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_STORAGE_VOLTAGE_MV, &storage_voltage_mv);
-        ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
-        // Read charge current for status update.
-        analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_CHARGE_CURRENT_UA, &(bcm_ctx.charge_current_ua));
-        ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
-        // Update maximum value.
-        if (bcm_ctx.charge_current_ua > bcm_ctx.charge_current_max_ua) {
-            bcm_ctx.charge_current_max_ua = bcm_ctx.charge_current_ua;
-        }
-#ifndef BCM_CHARGE_CONTROL_FORCED_HARDWARE
-        analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_SOURCE_VOLTAGE_MV, &(bcm_ctx.source_voltage_mv));
-        ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
-#endif
-        // Update LVF flag.
-        if (storage_voltage_mv < UNA_get_mv(SWREG_read_field((*reg_config_1_ptr), BCM_REGISTER_CONFIGURATION_1_MASK_LVF_STORAGE_VOLTAGE_THL))) {
-            SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b1, BCM_REGISTER_STATUS_1_MASK_LVF);
-        }
-        if (storage_voltage_mv > UNA_get_mv(SWREG_read_field((*reg_config_1_ptr), BCM_REGISTER_CONFIGURATION_1_MASK_LVF_STORAGE_VOLTAGE_THH))) {
-            SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b0, BCM_REGISTER_STATUS_1_MASK_LVF);
-        }
-        // Update CVF flag.
-        if (storage_voltage_mv < UNA_get_mv(SWREG_read_field((*reg_config_2_ptr), BCM_REGISTER_CONFIGURATION_2_MASK_CVF_STORAGE_VOLTAGE_THL))) {
-            SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b1, BCM_REGISTER_STATUS_1_MASK_CVF);
-        }
-        if (storage_voltage_mv > UNA_get_mv(SWREG_read_field((*reg_config_2_ptr), BCM_REGISTER_CONFIGURATION_2_MASK_CVF_STORAGE_VOLTAGE_THH))) {
-            SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b0, BCM_REGISTER_STATUS_1_MASK_CVF);
-        }
-    }
-errors:
-    POWER_disable(POWER_REQUESTER_ID_BCM, POWER_DOMAIN_ANALOG);
-    return status;
-}
-
 #ifndef BCM_CHARGE_CONTROL_FORCED_HARDWARE
 /*******************************************************************/
 NODE_status_t BCM_charge_process(void) {
@@ -448,7 +482,7 @@ NODE_status_t BCM_charge_process(void) {
     }
     if (uptime_seconds >= (bcm_ctx.charge_toggle_previous_time_seconds + BCM_CHARGE_TOGGLE_DURATION_SECONDS)) {
         // Check voltage.
-        if (bcm_ctx.source_voltage_mv >= UNA_get_mv(SWREG_read_field(reg_config_0, BCM_REGISTER_CONFIGURATION_0_MASK_CHARGE_SOURCE_VOLTAGE_TH))) {
+        if (bcm_ctx.monitor_data[BCM_MONITOR_CHANNEL_SOURCE_VOLTAGE] >= UNA_get_mv(SWREG_read_field(reg_config_0, BCM_REGISTER_CONFIGURATION_0_MASK_CHARGE_SOURCE_VOLTAGE_TH))) {
             // Enable charge.
             LOAD_set_charge_state(1);
         }
@@ -457,6 +491,11 @@ NODE_status_t BCM_charge_process(void) {
             LOAD_set_charge_state(0);
         }
     }
+    // Register next toggle steps.
+    SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, bcm_ctx.charge_toggle_next_time_seconds);
+    if (uptime_seconds < (bcm_ctx.charge_toggle_previous_time_seconds + BCM_CHARGE_TOGGLE_DURATION_SECONDS)) {
+        SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, (bcm_ctx.charge_toggle_previous_time_seconds + BCM_CHARGE_TOGGLE_DURATION_SECONDS));
+    }
 errors:
     return status;
 }
@@ -14,11 +14,14 @@
 #include "dsm_flags.h"
 #include "dsm_flags_slave.h"
 #include "error.h"
+#include "gauge.h"
 #include "load.h"
+#include "monitor.h"
 #include "node_register.h"
 #include "node_status.h"
 #include "swreg.h"
 #include "rtc.h"
+#include "scheduler.h"
 #include "types.h"
 #include "una.h"
 
@@ -35,6 +38,12 @@
 #define BPSM_XVF_STORAGE_VOLTAGE_TH_MV_MAX          60000
 #define BPSM_XVF_UPDATE_PERIOD_SECONDS              5
 
+#ifdef BPSM_STORAGE_CAPACITY_MAH
+// Note: there is no storage current measurement, the gauge is always recalibrated on voltage.
+#define BPSM_GAUGE_REST_CURRENT_UA                  0
+#define BPSM_GAUGE_REST_DURATION_SECONDS            60
+#endif
+
 #ifdef BPSM_CHARGE_CONTROL_FORCED_HARDWARE
 #define BPSM_FLAG_CCFH                              0b1
 #else
@@ -53,13 +62,21 @@
 
 /*** BPSM local structures ***/
 
+/*******************************************************************/
+typedef enum {
+    BPSM_MONITOR_CHANNEL_STORAGE_VOLTAGE = 0,
+#ifndef BPSM_CHARGE_CONTROL_FORCED_HARDWARE
+    BPSM_MONITOR_CHANNEL_SOURCE_VOLTAGE,
+#endif
+    BPSM_MONITOR_CHANNEL_LAST
+} BPSM_monitor_channel_t;
+
 /*******************************************************************/
 typedef struct {
     UNA_bit_representation_t charge_control_state;
     UNA_bit_representation_t backup_control_state;
-    uint32_t lvf_cvf_update_next_time_seconds;
+    int32_t monitor_data[BPSM_MONITOR_CHANNEL_LAST];
 #ifndef BPSM_CHARGE_CONTROL_FORCED_HARDWARE
-    int32_t source_voltage_mv;
     uint32_t charge_toggle_previous_time_seconds;
     uint32_t charge_toggle_next_time_seconds;
 #endif
@@ -70,28 +87,86 @@ typedef struct {
 static BPSM_context_t bpsm_ctx = {
     .charge_control_state = UNA_BIT_ERROR,
     .backup_control_state = UNA_BIT_ERROR,
-    .lvf_cvf_update_next_time_seconds = 0,
 #ifndef BPSM_CHARGE_CONTROL_FORCED_HARDWARE
-    .source_voltage_mv = 0,
     .charge_toggle_previous_time_seconds = 0,
     .charge_toggle_next_time_seconds = 0,
 #endif
 };
 
+#ifdef BPSM_STORAGE_CAPACITY_MAH
+// Supercapacitor charge is proportional to its voltage.
+static const GAUGE_ocv_point_t BPSM_GAUGE_OCV_TABLE[] = {
+    { 0, 0 },
+    { 2700, 100 }
+};
+
+static const GAUGE_configuration_t BPSM_GAUGE_CONFIGURATION = {
+    .capacity_mah = BPSM_STORAGE_CAPACITY_MAH,
+    .ocv_table = BPSM_GAUGE_OCV_TABLE,
+    .ocv_table_size = (sizeof(BPSM_GAUGE_OCV_TABLE) / sizeof(GAUGE_ocv_point_t)),
+    .rest_current_ua = BPSM_GAUGE_REST_CURRENT_UA,
+    .rest_duration_seconds = BPSM_GAUGE_REST_DURATION_SECONDS
+};
+#endif
+
+static const ANALOG_channel_t BPSM_MONITOR_CHANNEL[BPSM_MONITOR_CHANNEL_LAST] = {
+    ANALOG_CHANNEL_STORAGE_VOLTAGE_MV,
+#ifndef BPSM_CHARGE_CONTROL_FORCED_HARDWARE
+    ANALOG_CHANNEL_SOURCE_VOLTAGE_MV,
+#endif
+};
+
+static const MONITOR_hysteresis_t BPSM_MONITOR_HYSTERESIS[] = {
+    { BPSM_MONITOR_CHANNEL_STORAGE_VOLTAGE, BPSM_REGISTER_ADDRESS_CONFIGURATION_1, BPSM_REGISTER_CONFIGURATION_1_MASK_LVF_STORAGE_VOLTAGE_THL, BPSM_REGISTER_CONFIGURATION_1_MASK_LVF_STORAGE_VOLTAGE_THH, BPSM_REGISTER_ADDRESS_STATUS_1, BPSM_REGISTER_STATUS_1_MASK_LVF, NULL },
+    { BPSM_MONITOR_CHANNEL_STORAGE_VOLTAGE, BPSM_REGISTER_ADDRESS_CONFIGURATION_2, BPSM_REGISTER_CONFIGURATION_2_MASK_CVF_STORAGE_VOLTAGE_THL, BPSM_REGISTER_CONFIGURATION_2_MASK_CVF_STORAGE_VOLTAGE_THH, BPSM_REGISTER_ADDRESS_STATUS_1, BPSM_REGISTER_STATUS_1_MASK_CVF, NULL }
+};
+
+#ifdef BPSM_STORAGE_CAPACITY_MAH
+/*** BPSM local functions ***/
+
+/*******************************************************************/
+static NODE_status_t _BPSM_monitor_completion_callback(void) {
+    // Update state of charge.
+    return GAUGE_update(bpsm_ctx.monitor_data[BPSM_MONITOR_CHANNEL_STORAGE_VOLTAGE], 0);
+}
+#endif
+
+/*** BPSM global variables ***/
+
+const MONITOR_configuration_t BPSM_MONITOR_CONFIGURATION = {
+    .power_requester_id = POWER_REQUESTER_ID_BPSM,
+    .period_seconds = BPSM_XVF_UPDATE_PERIOD_SECONDS,
+    .channels = BPSM_MONITOR_CHANNEL,
+    .number_of_channels = BPSM_MONITOR_CHANNEL_LAST,
+    .data = bpsm_ctx.monitor_data,
+    .hysteresis = BPSM_MONITOR_HYSTERESIS,
+    .number_of_hysteresis = (sizeof(BPSM_MONITOR_HYSTERESIS) / sizeof(MONITOR_hysteresis_t)),
+#ifdef BPSM_STORAGE_CAPACITY_MAH
+    .completion_callback = &_BPSM_monitor_completion_callback
+#else
+    .completion_callback = NULL
+#endif
+};
+
 /*** BPSM functions ***/
 
 /*******************************************************************/
 NODE_status_t BPSM_init(void) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
+    uint8_t idx = 0;
     // Init context.
     bpsm_ctx.charge_control_state = UNA_BIT_ERROR;
     bpsm_ctx.backup_control_state = UNA_BIT_ERROR;
-    bpsm_ctx.lvf_cvf_update_next_time_seconds = 0;
+    for (idx = 0; idx < BPSM_MONITOR_CHANNEL_LAST; idx++) {
+        bpsm_ctx.monitor_data[idx] = 0;
+    }
 #ifndef BPSM_CHARGE_CONTROL_FORCED_HARDWARE
-    bpsm_ctx.source_voltage_mv = 0;
     bpsm_ctx.charge_toggle_previous_time_seconds = 0;
     bpsm_ctx.charge_toggle_next_time_seconds = 0;
+#endif
+#ifdef BPSM_STORAGE_CAPACITY_MAH
+    GAUGE_init(&BPSM_GAUGE_CONFIGURATION);
 #endif
     return status;
 }
@@ -345,50 +420,6 @@ errors:
     return status;
 }
 
-/*******************************************************************/
-NODE_status_t BPSM_low_voltage_detector_process(void) {
-    // Local variables.
-    NODE_status_t status = NODE_SUCCESS;
-    ANALOG_status_t analog_status = ANALOG_SUCCESS;
-    uint32_t uptime_seconds = RTC_get_uptime_seconds();
-    uint32_t* reg_config_1_ptr = &(NODE_RAM_REGISTER[BPSM_REGISTER_ADDRESS_CONFIGURATION_1]);
-    uint32_t* reg_config_2_ptr = &(NODE_RAM_REGISTER[BPSM_REGISTER_ADDRESS_CONFIGURATION_2]);
-    uint32_t* reg_status_1_ptr = &(NODE_RAM_REGISTER[BPSM_REGISTER_ADDRESS_STATUS_1]);
-    int32_t storage_voltage_mv = 0;
-    uint32_t unused_mask = 0;
-    // Check period.
-    if (uptime_seconds >= bpsm_ctx.lvf_cvf_update_next_time_seconds) {
-        // Update next time.
-        bpsm_ctx.lvf_cvf_update_next_time_seconds = uptime_seconds + BPSM_XVF_UPDATE_PERIOD_SECONDS;
-        // Turn analog front-end on.
-        POWER_enable(POWER_REQUESTER_ID_BPSM, POWER_DOMAIN_ANALOG, LPTIM_DELAY_MODE_ACTIVE);
-        // Read source voltage.
-        analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_STORAGE_VOLTAGE_MV, &storage_voltage_mv);
-        ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
-#ifndef BPSM_CHARGE_CONTROL_FORCED_HARDWARE
-        analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_SOURCE_VOLTAGE_MV, &(bpsm_ctx.source_voltage_mv));
-        ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
-#endif
-        // Update LVF flag.
-        if (storage_voltage_mv < UNA_get_mv(SWREG_read_field((*reg_config_1_ptr), BPSM_REGISTER_CONFIGURATION_1_MASK_LVF_STORAGE_VOLTAGE_THL))) {
-            SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b1, BPSM_REGISTER_STATUS_1_MASK_LVF);
-        }
-        if (storage_voltage_mv > UNA_get_mv(SWREG_read_field((*reg_config_1_ptr), BPSM_REGISTER_CONFIGURATION_1_MASK_LVF_STORAGE_VOLTAGE_THH))) {
-            SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b0, BPSM_REGISTER_STATUS_1_MASK_LVF);
-        }
-        // Update CVF flag.
-        if (storage_voltage_mv < UNA_get_mv(SWREG_read_field((*reg_config_2_ptr), BPSM_REGISTER_CONFIGURATION_2_MASK_CVF_STORAGE_VOLTAGE_THL))) {
-            SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b1, BPSM_REGISTER_STATUS_1_MASK_CVF);
-        }
-        if (storage_voltage_mv > UNA_get_mv(SWREG_read_field((*reg_config_2_ptr), BPSM_REGISTER_CONFIGURATION_2_MASK_CVF_STORAGE_VOLTAGE_THH))) {
-            SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b0, BPSM_REGISTER_STATUS_1_MASK_CVF);
-        }
-    }
-errors:
-    POWER_disable(POWER_REQUESTER_ID_BPSM, POWER_DOMAIN_ANALOG);
-    return status;
-}
-
 #ifndef BPSM_CHARGE_CONTROL_FORCED_HARDWARE
 /*******************************************************************/
 NODE_status_t BPSM_charge_process(void) {
@@ -409,7 +440,7 @@ NODE_status_t BPSM_charge_process(void) {
     }
     if (uptime_seconds >= (bpsm_ctx.charge_toggle_previous_time_seconds + BPSM_CHARGE_TOGGLE_DURATION_SECONDS)) {
         // Check voltage.
-        if (bpsm_ctx.source_voltage_mv >= UNA_get_mv(SWREG_read_field(reg_config_0, BPSM_REGISTER_CONFIGURATION_0_MASK_CHARGE_SOURCE_VOLTAGE_TH))) {
+        if (bpsm_ctx.monitor_data[BPSM_MONITOR_CHANNEL_SOURCE_VOLTAGE] >= UNA_get_mv(SWREG_read_field(reg_config_0, BPSM_REGISTER_CONFIGURATION_0_MASK_CHARGE_SOURCE_VOLTAGE_TH))) {
             // Enable charge.
             LOAD_set_charge_state(1);
         }
@@ -418,6 +449,11 @@ NODE_status_t BPSM_charge_process(void) {
             LOAD_set_charge_state(0);
         }
     }
+    // Register next toggle steps.
+    SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, bpsm_ctx.charge_toggle_next_time_seconds);
+    if (uptime_seconds < (bpsm_ctx.charge_toggle_previous_time_seconds + BPSM_CHARGE_TOGGLE_DURATION_SECONDS)) {
+        SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, (bpsm_ctx.charge_toggle_previous_time_seconds + BPSM_CHARGE_TOGGLE_DURATION_SECONDS));
+    }
 errors:
     return status;
 }
@@ -15,6 +15,8 @@
 #include "dsm_flags.h"
 #include "dsm_flags_slave.h"
 #include "error.h"
+#include "error_base.h"
+#include "error_log.h"
 #include "gpsm.h"
 #include "lvrm.h"
 #include "mpmcm.h"
@@ -143,13 +145,23 @@ void COMMON_refresh_register(uint8_t reg_addr) {
     // Check address.
     switch (reg_addr) {
     case COMMON_REGISTER_ADDRESS_ERROR_STACK:
+#ifdef DSM_ERROR_LOG
+        ERROR_LOG_import_stack();
+        SWREG_write_field(reg_ptr, &unused_mask, (uint32_t) ERROR_LOG_read(), COMMON_REGISTER_ERROR_STACK_MASK_ERROR);
+#else
         SWREG_write_field(reg_ptr, &unused_mask, (uint32_t) ERROR_stack_read(), COMMON_REGISTER_ERROR_STACK_MASK_ERROR);
+#endif
         break;
     case COMMON_REGISTER_ADDRESS_STATUS_0:
+#ifdef DSM_ERROR_LOG
+        ERROR_LOG_import_stack();
+        SWREG_write_field(reg_ptr, &unused_mask, ((ERROR_LOG_is_empty() == 0) ? 0b1 : 0b0), COMMON_REGISTER_STATUS_0_MASK_ESF);
+#else
 #ifdef UHFM
         ERROR_import_sigfox_stack();
 #endif
         SWREG_write_field(reg_ptr, &unused_mask, ((ERROR_stack_is_empty() == 0) ? 0b1 : 0b0), COMMON_REGISTER_STATUS_0_MASK_ESF);
+#endif
         break;
     default:
         break;
@@ -0,0 +1,225 @@
+/*
+ * gauge.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "gauge.h"
+
+#include "node_status.h"
+#include "rtc.h"
+#include "types.h"
+
+/*** GAUGE local macros ***/
+
+#define GAUGE_UAS_PER_MAH                   3600000
+#define GAUGE_SECONDS_PER_MINUTE            60
+
+#define GAUGE_DISCHARGE_CURRENT_FILTER      8
+// Rest voltage estimation error which is not corrected (2% of the capacity).
+#define GAUGE_CALIBRATION_DEADBAND_PER_MILLE    20
+
+/*** GAUGE local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    const GAUGE_configuration_t* configuration;
+    uint8_t initialized;
+    uint8_t rest_calibrated;
+    uint32_t previous_time_seconds;
+    uint32_t rest_start_time_seconds;
+    uint32_t calibration_time_seconds;
+    int64_t stored_charge_uas;
+    int64_t calibration_charge_uas;
+    int64_t charged_uas;
+    int64_t discharged_uas;
+    int32_t discharge_current_ua;
+} GAUGE_context_t;
+
+/*** GAUGE local global variables ***/
+
+static GAUGE_context_t gauge_ctx = {
+    .configuration = NULL,
+    .initialized = 0,
+    .rest_calibrated = 0,
+    .previous_time_seconds = 0,
+    .rest_start_time_seconds = 0,
+    .calibration_time_seconds = 0,
+    .stored_charge_uas = 0,
+    .calibration_charge_uas = 0,
+    .charged_uas = 0,
+    .discharged_uas = 0,
+    .discharge_current_ua = 0,
+};
+
+/*** GAUGE local functions ***/
+
+/*******************************************************************/
+static int64_t _GAUGE_get_capacity_uas(void) {
+    return ((int64_t) gauge_ctx.configuration->capacity_mah * (int64_t) GAUGE_UAS_PER_MAH);
+}
+
+/*******************************************************************/
+static int64_t _GAUGE_get_rest_charge_uas(int32_t storage_voltage_mv) {
+    // Local variables.
+    const GAUGE_ocv_point_t* ocv_table = gauge_ctx.configuration->ocv_table;
+    uint8_t last_idx = (uint8_t) (gauge_ctx.configuration->ocv_table_size - 1);
+    int64_t soc_per_million = 0;
+    uint8_t idx = 0;
+    // Saturate on table limits.
+    if (storage_voltage_mv <= ocv_table[0].voltage_mv) {
+        soc_per_million = ((int64_t) ocv_table[0].soc_percent * 10000);
+    }
+    else if (storage_voltage_mv >= ocv_table[last_idx].voltage_mv) {
+        soc_per_million = ((int64_t) ocv_table[last_idx].soc_percent * 10000);
+    }
+    else {
+        // Search segment.
+        for (idx = 0; idx < last_idx; idx++) {
+            if (storage_voltage_mv < ocv_table[idx + 1].voltage_mv) break;
+        }
+        // Linear interpolation.
+        soc_per_million = ((int64_t) ocv_table[idx].soc_percent * 10000);
+        soc_per_million += ((int64_t) (storage_voltage_mv - ocv_table[idx].voltage_mv) * (int64_t) (ocv_table[idx + 1].soc_percent - ocv_table[idx].soc_percent) * 10000) / ((int64_t) (ocv_table[idx + 1].voltage_mv - ocv_table[idx].voltage_mv));
+    }
+    return ((_GAUGE_get_capacity_uas() * soc_per_million) / 1000000);
+}
+
+/*******************************************************************/
+static void _GAUGE_calibrate(int32_t storage_voltage_mv, uint32_t uptime_seconds) {
+    // Local variables.
+    int64_t rest_charge_uas = _GAUGE_get_rest_charge_uas(storage_voltage_mv);
+    int64_t delta_uas = (rest_charge_uas - gauge_ctx.stored_charge_uas);
+    int64_t deadband_uas = ((_GAUGE_get_capacity_uas() * GAUGE_CALIBRATION_DEADBAND_PER_MILLE) / 1000);
+    uint32_t duration_seconds = (uptime_seconds - gauge_ctx.calibration_time_seconds);
+    int32_t discharge_current_ua = 0;
+    uint8_t correction_flag = ((delta_uas > deadband_uas) || (delta_uas < (-deadband_uas))) ? 1 : 0;
+    // Skip the discharge current estimation on the first calibration of a rest period, which also compensates the charge integration error.
+    if (gauge_ctx.rest_calibrated != 0) {
+        // Keep the estimated charge as long as the rest voltage agrees within the deadband.
+        if (correction_flag == 0) goto errors;
+        // Compute discharge current from the rest charge drop since the previous calibration.
+        if ((duration_seconds > 0) && (rest_charge_uas < gauge_ctx.calibration_charge_uas)) {
+            discharge_current_ua = (int32_t) ((gauge_ctx.calibration_charge_uas - rest_charge_uas) / ((int64_t) duration_seconds));
+            if (gauge_ctx.discharge_current_ua == 0) {
+                gauge_ctx.discharge_current_ua = discharge_current_ua;
+            }
+            else {
+                gauge_ctx.discharge_current_ua += ((discharge_current_ua - gauge_ctx.discharge_current_ua) / GAUGE_DISCHARGE_CURRENT_FILTER);
+            }
+        }
+    }
+    // Correct the stored charge only: charged and discharged counters are not modified.
+    if (correction_flag != 0) {
+        gauge_ctx.stored_charge_uas = rest_charge_uas;
+    }
+    // Update reference.
+    gauge_ctx.calibration_charge_uas = rest_charge_uas;
+    gauge_ctx.calibration_time_seconds = uptime_seconds;
+    gauge_ctx.rest_calibrated = 1;
+errors:
+    return;
+}
+
+/*** GAUGE functions ***/
+
+/*******************************************************************/
+void GAUGE_init(const GAUGE_configuration_t* configuration) {
+    // Init context.
+    gauge_ctx.configuration = configuration;
+    gauge_ctx.initialized = 0;
+    gauge_ctx.rest_calibrated = 0;
+    gauge_ctx.previous_time_seconds = 0;
+    gauge_ctx.rest_start_time_seconds = 0;
+    gauge_ctx.calibration_time_seconds = 0;
+    gauge_ctx.stored_charge_uas = 0;
+    gauge_ctx.calibration_charge_uas = 0;
+    gauge_ctx.charged_uas = 0;
+    gauge_ctx.discharged_uas = 0;
+    gauge_ctx.discharge_current_ua = 0;
+}
+
+/*******************************************************************/
+NODE_status_t GAUGE_update(int32_t storage_voltage_mv, int32_t charge_current_ua) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    uint32_t uptime_seconds = RTC_get_uptime_seconds();
+    int64_t capacity_uas = 0;
+    int64_t charge_uas = 0;
+    // Check configuration.
+    if ((gauge_ctx.configuration == NULL) || (gauge_ctx.configuration->ocv_table == NULL) || (gauge_ctx.configuration->ocv_table_size == 0)) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    capacity_uas = _GAUGE_get_capacity_uas();
+    // Start from the current voltage.
+    if (gauge_ctx.initialized == 0) {
+        gauge_ctx.stored_charge_uas = _GAUGE_get_rest_charge_uas(storage_voltage_mv);
+        gauge_ctx.calibration_charge_uas = gauge_ctx.stored_charge_uas;
+        gauge_ctx.previous_time_seconds = uptime_seconds;
+        gauge_ctx.rest_start_time_seconds = uptime_seconds;
+        gauge_ctx.calibration_time_seconds = uptime_seconds;
+        gauge_ctx.initialized = 1;
+        goto errors;
+    }
+    // Check charge current.
+    if (charge_current_ua > (gauge_ctx.configuration->rest_current_ua)) {
+        // Integrate charge since last update.
+        charge_uas = ((int64_t) charge_current_ua * (int64_t) (uptime_seconds - gauge_ctx.previous_time_seconds));
+        gauge_ctx.stored_charge_uas += charge_uas;
+        gauge_ctx.charged_uas += charge_uas;
+        // Restart rest period.
+        gauge_ctx.rest_start_time_seconds = uptime_seconds;
+        gauge_ctx.calibration_time_seconds = uptime_seconds;
+        gauge_ctx.rest_calibrated = 0;
+    }
+    else {
+        // Integrate estimated discharge current since last update.
+        charge_uas = ((int64_t) gauge_ctx.discharge_current_ua * (int64_t) (uptime_seconds - gauge_ctx.previous_time_seconds));
+        if (charge_uas > gauge_ctx.stored_charge_uas) {
+            charge_uas = gauge_ctx.stored_charge_uas;
+        }
+        gauge_ctx.stored_charge_uas -= charge_uas;
+        gauge_ctx.discharged_uas += charge_uas;
+        // Check rest period.
+        if (((uptime_seconds - gauge_ctx.rest_start_time_seconds) >= (gauge_ctx.configuration->rest_duration_seconds)) &&
+            ((uptime_seconds - gauge_ctx.calibration_time_seconds) >= (gauge_ctx.configuration->rest_duration_seconds))) {
+            // Voltage is relaxed enough to be used as reference.
+            _GAUGE_calibrate(storage_voltage_mv, uptime_seconds);
+        }
+    }
+    gauge_ctx.previous_time_seconds = uptime_seconds;
+    // Clamp to storage element capacity.
+    if (gauge_ctx.stored_charge_uas > capacity_uas) {
+        gauge_ctx.stored_charge_uas = capacity_uas;
+    }
+    if (gauge_ctx.stored_charge_uas < 0) {
+        gauge_ctx.stored_charge_uas = 0;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+NODE_status_t GAUGE_get_data(GAUGE_data_t* gauge_data) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    int64_t capacity_uas = 0;
+    // Check parameters.
+    if ((gauge_data == NULL) || (gauge_ctx.configuration == NULL)) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    capacity_uas = _GAUGE_get_capacity_uas();
+    // Compute data.
+    gauge_data->soc_percent = (capacity_uas == 0) ? 0 : (uint8_t) ((gauge_ctx.stored_charge_uas * 100) / capacity_uas);
+    gauge_data->charged_mah = (uint32_t) (gauge_ctx.charged_uas / GAUGE_UAS_PER_MAH);
+    gauge_data->discharged_mah = (uint32_t) (gauge_ctx.discharged_uas / GAUGE_UAS_PER_MAH);
+    gauge_data->runtime_minutes = GAUGE_RUNTIME_UNKNOWN;
+    if (gauge_ctx.discharge_current_ua > 0) {
+        gauge_data->runtime_minutes = (uint32_t) ((gauge_ctx.stored_charge_uas / gauge_ctx.discharge_current_ua) / GAUGE_SECONDS_PER_MINUTE);
+    }
+errors:
+    return status;
+}
@@ -69,13 +69,15 @@ typedef union {
 typedef struct {
     GPSM_flags_t flags;
     UNA_bit_representation_t backup_control_state;
+    GPS_acquisition_type_t acquisition_type;
 } GPSM_context_t;
 
 /*** GPSM local global variables ***/
 
 static GPSM_context_t gpsm_ctx = {
     .flags.all = 0,
-    .backup_control_state = UNA_BIT_ERROR
+    .backup_control_state = UNA_BIT_ERROR,
+    .acquisition_type = GPS_ACQUISITION_TYPE_LAST
 };
 
 /*** GPSM local functions ***/
@@ -123,95 +125,119 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+static NODE_status_t _GPSM_start_acquisition(GPS_acquisition_type_t acquisition_type, uint32_t timeout_seconds) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    GPS_status_t gps_status = GPS_SUCCESS;
+    // Check GPS state.
+    if (GPS_get_acquisition_state() == GPS_ACQUISITION_STATE_RUNNING) {
+        // Nothing to do if the same acquisition is already running.
+        if (acquisition_type == gpsm_ctx.acquisition_type) goto errors;
+        status = NODE_ERROR_RADIO_STATE;
+        goto errors;
+    }
+    // Turn GPS on.
+    status = _GPSM_power_request(1);
+    if (status != NODE_SUCCESS) goto errors;
+    // Start acquisition in background.
+    gps_status = GPS_start_acquisition(acquisition_type, timeout_seconds);
+    GPS_exit_error(NODE_ERROR_BASE_GPS);
+    // Update context.
+    gpsm_ctx.acquisition_type = acquisition_type;
+errors:
+    return status;
+}
+
 /*******************************************************************/
 static NODE_status_t _GPSM_ttrg_callback(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    uint32_t reg_config_0 = NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_CONFIGURATION_0];
+    uint32_t* reg_status_1_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_STATUS_1]);
+    uint32_t unused_mask = 0;
+    // Start time fix.
+    status = _GPSM_start_acquisition(GPS_ACQUISITION_TYPE_TIME, SWREG_read_field(reg_config_0, GPSM_REGISTER_CONFIGURATION_0_MASK_TIME_TIMEOUT));
+    if (status != NODE_SUCCESS) goto errors;
+    // Reset status flag only once the new acquisition is running.
+    SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b0, GPSM_REGISTER_STATUS_1_MASK_TFST);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static NODE_status_t _GPSM_gtrg_callback(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    uint32_t reg_config_0 = NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_CONFIGURATION_0];
+    uint32_t* reg_status_1_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_STATUS_1]);
+    uint32_t unused_mask = 0;
+    // Start geolocation fix.
+    status = _GPSM_start_acquisition(GPS_ACQUISITION_TYPE_POSITION, SWREG_read_field(reg_config_0, GPSM_REGISTER_CONFIGURATION_0_MASK_GEOLOC_TIMEOUT));
+    if (status != NODE_SUCCESS) goto errors;
+    // Reset status flag only once the new acquisition is running.
+    SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b0, GPSM_REGISTER_STATUS_1_MASK_GFST);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static NODE_status_t _GPSM_ttrg_completion(uint32_t time_fix_duration) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
     GPS_status_t gps_status = GPS_SUCCESS;
-    GPS_acquisition_status_t gps_acquisition_status = GPS_ACQUISITION_ERROR_LAST;
     GPS_time_t gps_time;
-    uint32_t time_fix_duration = 0;
-    uint32_t reg_config_0 = NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_CONFIGURATION_0];
     uint32_t* reg_status_1_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_STATUS_1]);
     uint32_t* reg_time_data_0_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_TIME_DATA_0]);
     uint32_t* reg_time_data_1_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_TIME_DATA_1]);
     uint32_t* reg_time_data_2_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_TIME_DATA_2]);
     uint32_t unused_mask = 0;
-    // Reset status flag.
-    SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b0, GPSM_REGISTER_STATUS_1_MASK_TFST);
-    // Turn GPS on.
-    status = _GPSM_power_request(1);
-    if (status != NODE_SUCCESS) goto errors;
-    // Perform time fix.
-    gps_status = GPS_get_time(&gps_time, SWREG_read_field(reg_config_0, GPSM_REGISTER_CONFIGURATION_0_MASK_TIME_TIMEOUT), &time_fix_duration, &gps_acquisition_status);
+    // Read data.
+    gps_status = GPS_get_time(&gps_time);
     GPS_exit_error(NODE_ERROR_BASE_GPS);
-    // Check acquisition status.
-    if (gps_acquisition_status == GPS_ACQUISITION_SUCCESS) {
-        // Update status flag.
-        SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b1, GPSM_REGISTER_STATUS_1_MASK_TFST);
-        // Fill registers with time data.
-        SWREG_write_field(reg_time_data_0_ptr, &unused_mask, (uint32_t) UNA_convert_year(gps_time.year), GPSM_REGISTER_TIME_DATA_0_MASK_YEAR);
-        SWREG_write_field(reg_time_data_0_ptr, &unused_mask, (uint32_t) gps_time.month, GPSM_REGISTER_TIME_DATA_0_MASK_MONTH);
-        SWREG_write_field(reg_time_data_0_ptr, &unused_mask, (uint32_t) gps_time.date, GPSM_REGISTER_TIME_DATA_0_MASK_DATE);
-        SWREG_write_field(reg_time_data_1_ptr, &unused_mask, (uint32_t) gps_time.hours, GPSM_REGISTER_TIME_DATA_1_MASK_HOUR);
-        SWREG_write_field(reg_time_data_1_ptr, &unused_mask, (uint32_t) gps_time.minutes, GPSM_REGISTER_TIME_DATA_1_MASK_MINUTE);
-        SWREG_write_field(reg_time_data_1_ptr, &unused_mask, (uint32_t) gps_time.seconds, GPSM_REGISTER_TIME_DATA_1_MASK_SECOND);
-        SWREG_write_field(reg_time_data_2_ptr, &unused_mask, time_fix_duration, GPSM_REGISTER_TIME_DATA_2_MASK_FIX_DURATION);
-    }
-    // Turn GPS off is possible.
-    status = _GPSM_power_request(0);
-    if (status != NODE_SUCCESS) goto errors;
+    // Update status flag.
+    SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b1, GPSM_REGISTER_STATUS_1_MASK_TFST);
+    // Fill registers with time data.
+    SWREG_write_field(reg_time_data_0_ptr, &unused_mask, (uint32_t) UNA_convert_year(gps_time.year), GPSM_REGISTER_TIME_DATA_0_MASK_YEAR);
+    SWREG_write_field(reg_time_data_0_ptr, &unused_mask, (uint32_t) gps_time.month, GPSM_REGISTER_TIME_DATA_0_MASK_MONTH);
+    SWREG_write_field(reg_time_data_0_ptr, &unused_mask, (uint32_t) gps_time.date, GPSM_REGISTER_TIME_DATA_0_MASK_DATE);
+    SWREG_write_field(reg_time_data_1_ptr, &unused_mask, (uint32_t) gps_time.hours, GPSM_REGISTER_TIME_DATA_1_MASK_HOUR);
+    SWREG_write_field(reg_time_data_1_ptr, &unused_mask, (uint32_t) gps_time.minutes, GPSM_REGISTER_TIME_DATA_1_MASK_MINUTE);
+    SWREG_write_field(reg_time_data_1_ptr, &unused_mask, (uint32_t) gps_time.seconds, GPSM_REGISTER_TIME_DATA_1_MASK_SECOND);
+    SWREG_write_field(reg_time_data_2_ptr, &unused_mask, time_fix_duration, GPSM_REGISTER_TIME_DATA_2_MASK_FIX_DURATION);
 errors:
-    // Turn GPS off is possible.
-    _GPSM_power_request(0);
     return status;
 }
 
 /*******************************************************************/
-static NODE_status_t _GPSM_gtrg_callback(void) {
+static NODE_status_t _GPSM_gtrg_completion(uint32_t geoloc_fix_duration) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
     GPS_status_t gps_status = GPS_SUCCESS;
-    GPS_acquisition_status_t gps_acquisition_status = GPS_ACQUISITION_ERROR_LAST;
     GPS_position_t gps_position;
-    uint32_t geoloc_fix_duration = 0;
-    uint32_t reg_config_0 = NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_CONFIGURATION_0];
     uint32_t* reg_status_1_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_STATUS_1]);
     uint32_t* reg_geoloc_data_0_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_GEOLOC_DATA_0]);
     uint32_t* reg_geoloc_data_1_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_GEOLOC_DATA_1]);
     uint32_t* reg_geoloc_data_2_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_GEOLOC_DATA_2]);
     uint32_t* reg_geoloc_data_3_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_GEOLOC_DATA_3]);
     uint32_t unused_mask = 0;
-    // Reset status flag.
-    SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b0, GPSM_REGISTER_STATUS_1_MASK_GFST);
-    // Turn GPS on.
-    status = _GPSM_power_request(1);
-    if (status != NODE_SUCCESS) goto errors;
-    // Perform time fix.
-    gps_status = GPS_get_position(&gps_position, SWREG_read_field(reg_config_0, GPSM_REGISTER_CONFIGURATION_0_MASK_GEOLOC_TIMEOUT), &geoloc_fix_duration, &gps_acquisition_status);
+    // Read data.
+    gps_status = GPS_get_position(&gps_position);
     GPS_exit_error(NODE_ERROR_BASE_GPS);
-    // Check acquisition status.
-    if (gps_acquisition_status == GPS_ACQUISITION_SUCCESS) {
-        // Update status flag.
-        SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b1, GPSM_REGISTER_STATUS_1_MASK_GFST);
-        // Fill registers with geoloc data.
-        SWREG_write_field(reg_geoloc_data_0_ptr, &unused_mask, (uint32_t) gps_position.lat_north_flag, GPSM_REGISTER_GEOLOC_DATA_0_MASK_NF);
-        SWREG_write_field(reg_geoloc_data_0_ptr, &unused_mask, gps_position.lat_seconds, GPSM_REGISTER_GEOLOC_DATA_0_MASK_SECOND);
-        SWREG_write_field(reg_geoloc_data_0_ptr, &unused_mask, (uint32_t) gps_position.lat_minutes, GPSM_REGISTER_GEOLOC_DATA_0_MASK_MINUTE);
-        SWREG_write_field(reg_geoloc_data_0_ptr, &unused_mask, (uint32_t) gps_position.lat_degrees, GPSM_REGISTER_GEOLOC_DATA_0_MASK_DEGREE);
-        SWREG_write_field(reg_geoloc_data_1_ptr, &unused_mask, (uint32_t) gps_position.long_east_flag, GPSM_REGISTER_GEOLOC_DATA_1_MASK_EF);
-        SWREG_write_field(reg_geoloc_data_1_ptr, &unused_mask, gps_position.long_seconds, GPSM_REGISTER_GEOLOC_DATA_1_MASK_SECOND);
-        SWREG_write_field(reg_geoloc_data_1_ptr, &unused_mask, (uint32_t) gps_position.long_minutes, GPSM_REGISTER_GEOLOC_DATA_1_MASK_MINUTE);
-        SWREG_write_field(reg_geoloc_data_1_ptr, &unused_mask, (uint32_t) gps_position.long_degrees, GPSM_REGISTER_GEOLOC_DATA_1_MASK_DEGREE);
-        SWREG_write_field(reg_geoloc_data_2_ptr, &unused_mask, gps_position.altitude, GPSM_REGISTER_GEOLOC_DATA_2_MASK_ALTITUDE);
-        SWREG_write_field(reg_geoloc_data_3_ptr, &unused_mask, geoloc_fix_duration, GPSM_REGISTER_GEOLOC_DATA_3_MASK_FIX_DURATION);
-    }
-    // Turn GPS off is possible.
-    status = _GPSM_power_request(0);
-    if (status != NODE_SUCCESS) goto errors;
+    // Update status flag.
+    SWREG_write_field(reg_status_1_ptr, &unused_mask, 0b1, GPSM_REGISTER_STATUS_1_MASK_GFST);
+    // Fill registers with geoloc data.
+    SWREG_write_field(reg_geoloc_data_0_ptr, &unused_mask, (uint32_t) gps_position.lat_north_flag, GPSM_REGISTER_GEOLOC_DATA_0_MASK_NF);
+    SWREG_write_field(reg_geoloc_data_0_ptr, &unused_mask, gps_position.lat_seconds, GPSM_REGISTER_GEOLOC_DATA_0_MASK_SECOND);
+    SWREG_write_field(reg_geoloc_data_0_ptr, &unused_mask, (uint32_t) gps_position.lat_minutes, GPSM_REGISTER_GEOLOC_DATA_0_MASK_MINUTE);
+    SWREG_write_field(reg_geoloc_data_0_ptr, &unused_mask, (uint32_t) gps_position.lat_degrees, GPSM_REGISTER_GEOLOC_DATA_0_MASK_DEGREE);
+    SWREG_write_field(reg_geoloc_data_1_ptr, &unused_mask, (uint32_t) gps_position.long_east_flag, GPSM_REGISTER_GEOLOC_DATA_1_MASK_EF);
+    SWREG_write_field(reg_geoloc_data_1_ptr, &unused_mask, gps_position.long_seconds, GPSM_REGISTER_GEOLOC_DATA_1_MASK_SECOND);
+    SWREG_write_field(reg_geoloc_data_1_ptr, &unused_mask, (uint32_t) gps_position.long_minutes, GPSM_REGISTER_GEOLOC_DATA_1_MASK_MINUTE);
+    SWREG_write_field(reg_geoloc_data_1_ptr, &unused_mask, (uint32_t) gps_position.long_degrees, GPSM_REGISTER_GEOLOC_DATA_1_MASK_DEGREE);
+    SWREG_write_field(reg_geoloc_data_2_ptr, &unused_mask, gps_position.altitude, GPSM_REGISTER_GEOLOC_DATA_2_MASK_ALTITUDE);
+    SWREG_write_field(reg_geoloc_data_3_ptr, &unused_mask, geoloc_fix_duration, GPSM_REGISTER_GEOLOC_DATA_3_MASK_FIX_DURATION);
 errors:
-    // Turn GPS off is possible.
-    _GPSM_power_request(0);
     return status;
 }
 
@@ -251,6 +277,7 @@ NODE_status_t GPSM_init(void) {
     // Init context.
     gpsm_ctx.flags.all = 0;
     gpsm_ctx.backup_control_state = UNA_BIT_ERROR;
+    gpsm_ctx.acquisition_type = GPS_ACQUISITION_TYPE_LAST;
     return status;
 }
 
@@ -385,22 +412,34 @@ NODE_status_t GPSM_process_register(uint8_t reg_addr, uint32_t reg_mask) {
         if ((reg_mask & GPSM_REGISTER_CONTROL_1_MASK_TTRG) != 0) {
             // Read bit.
             if (SWREG_read_field((*reg_ptr), GPSM_REGISTER_CONTROL_1_MASK_TTRG) != 0) {
-                // Clear request.
-                SWREG_write_field(reg_ptr, &unused_mask, 0b0, GPSM_REGISTER_CONTROL_1_MASK_TTRG);
-                // Start GPS time fix.
+                // Start GPS time fix (bit is cleared at the end of the acquisition).
                 status = _GPSM_ttrg_callback();
-                if (status != NODE_SUCCESS) goto errors;
+                if (status != NODE_SUCCESS) {
+                    // Clear request.
+                    SWREG_write_field(reg_ptr, &unused_mask, 0b0, GPSM_REGISTER_CONTROL_1_MASK_TTRG);
+                    // Release power only if no acquisition is running.
+                    if (GPS_get_acquisition_state() != GPS_ACQUISITION_STATE_RUNNING) {
+                        _GPSM_power_request(0);
+                    }
+                    goto errors;
+                }
             }
         }
         // GTRG.
         if ((reg_mask & GPSM_REGISTER_CONTROL_1_MASK_GTRG) != 0) {
             // Read bit.
             if (SWREG_read_field((*reg_ptr), GPSM_REGISTER_CONTROL_1_MASK_GTRG) != 0) {
-                // Clear request.
-                SWREG_write_field(reg_ptr, &unused_mask, 0b0, GPSM_REGISTER_CONTROL_1_MASK_GTRG);
-                // Start GPS geolocation fix.
+                // Start GPS geolocation fix (bit is cleared at the end of the acquisition).
                 status = _GPSM_gtrg_callback();
-                if (status != NODE_SUCCESS) goto errors;
+                if (status != NODE_SUCCESS) {
+                    // Clear request.
+                    SWREG_write_field(reg_ptr, &unused_mask, 0b0, GPSM_REGISTER_CONTROL_1_MASK_GTRG);
+                    // Release power only if no acquisition is running.
+                    if (GPS_get_acquisition_state() != GPS_ACQUISITION_STATE_RUNNING) {
+                        _GPSM_power_request(0);
+                    }
+                    goto errors;
+                }
             }
         }
         // TPEN.
@@ -486,6 +525,45 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+NODE_status_t GPSM_process(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    GPS_status_t gps_status = GPS_SUCCESS;
+    GPS_acquisition_status_t acquisition_status = GPS_ACQUISITION_ERROR_LAST;
+    uint32_t acquisition_duration_seconds = 0;
+    uint32_t* reg_control_1_ptr = &(NODE_RAM_REGISTER[GPSM_REGISTER_ADDRESS_CONTROL_1]);
+    uint32_t unused_mask = 0;
+    // Process GPS acquisition.
+    gps_status = GPS_process();
+    GPS_stack_error(ERROR_BASE_NODE + NODE_ERROR_BASE_GPS);
+    // Check acquisition end.
+    if (GPS_get_acquisition_state() != GPS_ACQUISITION_STATE_DONE) goto errors;
+    // Read result.
+    gps_status = GPS_get_acquisition_status(&acquisition_status, &acquisition_duration_seconds);
+    GPS_stack_error(ERROR_BASE_NODE + NODE_ERROR_BASE_GPS);
+    // Check acquisition type.
+    if (gpsm_ctx.acquisition_type == GPS_ACQUISITION_TYPE_TIME) {
+        if (acquisition_status == GPS_ACQUISITION_SUCCESS) {
+            status = _GPSM_ttrg_completion(acquisition_duration_seconds);
+        }
+        // Acquisition is done.
+        SWREG_write_field(reg_control_1_ptr, &unused_mask, 0b0, GPSM_REGISTER_CONTROL_1_MASK_TTRG);
+    }
+    if (gpsm_ctx.acquisition_type == GPS_ACQUISITION_TYPE_POSITION) {
+        if (acquisition_status == GPS_ACQUISITION_SUCCESS) {
+            status = _GPSM_gtrg_completion(acquisition_duration_seconds);
+        }
+        // Acquisition is done.
+        SWREG_write_field(reg_control_1_ptr, &unused_mask, 0b0, GPSM_REGISTER_CONTROL_1_MASK_GTRG);
+    }
+    gpsm_ctx.acquisition_type = GPS_ACQUISITION_TYPE_LAST;
+    // Turn GPS off is possible.
+    _GPSM_power_request(0);
+errors:
+    return status;
+}
+
 /*******************************************************************/
 NODE_status_t GPSM_mtrg_callback(void) {
     // Local variables.
@@ -15,9 +15,9 @@
 #include "error.h"
 #include "load.h"
 #include "lvrm_registers.h"
+#include "monitor.h"
 #include "node_register.h"
 #include "node_status.h"
-#include "rtc.h"
 #include "swreg.h"
 #include "types.h"
 #include "una.h"
@@ -43,13 +43,27 @@
 #define LVRM_FLAG_RCFH                                  0b0
 #endif
 
+/*** LVRM static functions declaration ***/
+
+#ifdef LVRM_MODE_BMS
+static NODE_status_t _LVRM_bms_callback(MONITOR_level_t level);
+#endif
+
 /*** LVRM local structures ***/
 
+#ifdef LVRM_MODE_BMS
+/*******************************************************************/
+typedef enum {
+    LVRM_MONITOR_CHANNEL_INPUT_VOLTAGE = 0,
+    LVRM_MONITOR_CHANNEL_LAST
+} LVRM_monitor_channel_t;
+#endif
+
 /*******************************************************************/
 typedef struct {
     UNA_bit_representation_t regulator_control_state;
 #ifdef LVRM_MODE_BMS
-    uint32_t bms_process_next_time_seconds;
+    int32_t monitor_data[LVRM_MONITOR_CHANNEL_LAST];
 #endif
 } LVRM_context_t;
 
@@ -57,10 +71,46 @@ typedef struct {
 
 static LVRM_context_t lvrm_ctx = {
     .regulator_control_state = UNA_BIT_ERROR,
+};
+
 #ifdef LVRM_MODE_BMS
-    .bms_process_next_time_seconds = 0,
+static const ANALOG_channel_t LVRM_MONITOR_CHANNEL[LVRM_MONITOR_CHANNEL_LAST] = {
+    ANALOG_CHANNEL_INPUT_VOLTAGE_MV
+};
+
+static const MONITOR_hysteresis_t LVRM_MONITOR_HYSTERESIS[] = {
+    { LVRM_MONITOR_CHANNEL_INPUT_VOLTAGE, LVRM_REGISTER_ADDRESS_CONFIGURATION_0, LVRM_REGISTER_CONFIGURATION_0_MASK_BMS_INPUT_VOLTAGE_THL, LVRM_REGISTER_CONFIGURATION_0_MASK_BMS_INPUT_VOLTAGE_THH, 0, 0, &_LVRM_bms_callback }
+};
 #endif
+
+#ifdef LVRM_MODE_BMS
+/*** LVRM local functions ***/
+
+/*******************************************************************/
+static NODE_status_t _LVRM_bms_callback(MONITOR_level_t level) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    LOAD_status_t load_status = LOAD_SUCCESS;
+    // Open relay on low battery voltage and close it when recovered.
+    load_status = LOAD_set_output_state((level == MONITOR_LEVEL_HIGH) ? 1 : 0);
+    LOAD_exit_error(NODE_ERROR_BASE_LOAD);
+errors:
+    return status;
+}
+
+/*** LVRM global variables ***/
+
+const MONITOR_configuration_t LVRM_MONITOR_CONFIGURATION = {
+    .power_requester_id = POWER_REQUESTER_ID_LVRM,
+    .period_seconds = LVRM_BMS_PROCESS_PERIOD_SECONDS,
+    .channels = LVRM_MONITOR_CHANNEL,
+    .number_of_channels = LVRM_MONITOR_CHANNEL_LAST,
+    .data = lvrm_ctx.monitor_data,
+    .hysteresis = LVRM_MONITOR_HYSTERESIS,
+    .number_of_hysteresis = (sizeof(LVRM_MONITOR_HYSTERESIS) / sizeof(MONITOR_hysteresis_t)),
+    .completion_callback = NULL
 };
+#endif
 
 /*** LVRM functions ***/
 
@@ -68,10 +118,15 @@ static LVRM_context_t lvrm_ctx = {
 NODE_status_t LVRM_init(void) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
+#ifdef LVRM_MODE_BMS
+    uint8_t idx = 0;
+#endif
     // Init context.
     lvrm_ctx.regulator_control_state = UNA_BIT_ERROR;
 #ifdef LVRM_MODE_BMS
-    lvrm_ctx.bms_process_next_time_seconds = 0;
+    for (idx = 0; idx < LVRM_MONITOR_CHANNEL_LAST; idx++) {
+        lvrm_ctx.monitor_data[idx] = 0;
+    }
 #endif
     return status;
 }
@@ -260,41 +315,4 @@ errors:
     return status;
 }
 
-#ifdef LVRM_MODE_BMS
-/*******************************************************************/
-NODE_status_t LVRM_bms_process(void) {
-    // Local variables.
-    NODE_status_t status = NODE_SUCCESS;
-    ANALOG_status_t analog_status = ANALOG_SUCCESS;
-    LOAD_status_t load_status = LOAD_SUCCESS;
-    uint32_t reg_config_0 = NODE_RAM_REGISTER[LVRM_REGISTER_ADDRESS_CONFIGURATION_0];
-    int32_t vbatt_mv = 0;
-    uint32_t uptime_seconds = RTC_get_uptime_seconds();
-    // Check period.
-    if (uptime_seconds >= lvrm_ctx.bms_process_next_time_seconds) {
-        // Update next time.
-        lvrm_ctx.bms_process_next_time_seconds = uptime_seconds + LVRM_BMS_PROCESS_PERIOD_SECONDS;
-        // Turn analog front-end on.
-        POWER_enable(POWER_REQUESTER_ID_LVRM, POWER_DOMAIN_ANALOG, LPTIM_DELAY_MODE_ACTIVE);
-        // Check battery voltage.
-        analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_INPUT_VOLTAGE_MV, &vbatt_mv);
-        ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
-        // Check battery voltage.
-        if (vbatt_mv < UNA_get_mv(SWREG_read_field(reg_config_0, LVRM_REGISTER_CONFIGURATION_0_MASK_BMS_INPUT_VOLTAGE_THL))) {
-            // Open relay.
-            load_status = LOAD_set_output_state(0);
-            LOAD_exit_error(NODE_ERROR_BASE_LOAD);
-        }
-        if (vbatt_mv > UNA_get_mv(SWREG_read_field(reg_config_0, LVRM_REGISTER_CONFIGURATION_0_MASK_BMS_INPUT_VOLTAGE_THH))) {
-            // Close relay.
-            load_status = LOAD_set_output_state(1);
-            LOAD_exit_error(NODE_ERROR_BASE_LOAD);
-        }
-    }
-errors:
-    POWER_disable(POWER_REQUESTER_ID_LVRM, POWER_DOMAIN_ANALOG);
-    return status;
-}
-#endif
-
 #endif /* LVRM */
@@ -0,0 +1,126 @@
+/*
+ * monitor.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "monitor.h"
+
+#include "analog.h"
+#include "error.h"
+#include "lptim.h"
+#include "node_register.h"
+#include "node_status.h"
+#include "power.h"
+#include "rtc.h"
+#include "scheduler.h"
+#include "swreg.h"
+#include "types.h"
+#include "una.h"
+
+/*** MONITOR local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    const MONITOR_configuration_t* configuration;
+    uint32_t next_time_seconds;
+} MONITOR_context_t;
+
+/*** MONITOR local global variables ***/
+
+static MONITOR_context_t monitor_ctx = {
+    .configuration = NULL,
+    .next_time_seconds = 0,
+};
+
+/*** MONITOR local functions ***/
+
+/*******************************************************************/
+static NODE_status_t _MONITOR_apply_hysteresis(const MONITOR_hysteresis_t* hysteresis) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    uint32_t reg_threshold = NODE_RAM_REGISTER[hysteresis->threshold_reg_addr];
+    MONITOR_level_t level = MONITOR_LEVEL_LAST;
+    int32_t data_mv = 0;
+    uint32_t unused_mask = 0;
+    // Check channel index.
+    if (hysteresis->channel_index >= monitor_ctx.configuration->number_of_channels) {
+        status = NODE_ERROR_MONITOR_CHANNEL_INDEX;
+        goto errors;
+    }
+    data_mv = monitor_ctx.configuration->data[hysteresis->channel_index];
+    // Compare to thresholds.
+    if (data_mv < UNA_get_mv(SWREG_read_field(reg_threshold, hysteresis->threshold_low_mask))) {
+        level = MONITOR_LEVEL_LOW;
+    }
+    if (data_mv > UNA_get_mv(SWREG_read_field(reg_threshold, hysteresis->threshold_high_mask))) {
+        level = MONITOR_LEVEL_HIGH;
+    }
+    // Keep previous state within hysteresis window.
+    if (level == MONITOR_LEVEL_LAST) goto errors;
+    // Update flag.
+    if (hysteresis->flag_mask != 0) {
+        SWREG_write_field(&(NODE_RAM_REGISTER[hysteresis->flag_reg_addr]), &unused_mask, ((level == MONITOR_LEVEL_LOW) ? 0b1 : 0b0), hysteresis->flag_mask);
+    }
+    // Execute action.
+    if (hysteresis->callback != NULL) {
+        status = hysteresis->callback(level);
+        if (status != NODE_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+
+/*** MONITOR functions ***/
+
+/*******************************************************************/
+void MONITOR_init(const MONITOR_configuration_t* configuration) {
+    // Init context.
+    monitor_ctx.configuration = configuration;
+    monitor_ctx.next_time_seconds = 0;
+}
+
+/*******************************************************************/
+NODE_status_t MONITOR_process(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    ANALOG_status_t analog_status = ANALOG_SUCCESS;
+    const MONITOR_configuration_t* configuration = monitor_ctx.configuration;
+    uint32_t uptime_seconds = RTC_get_uptime_seconds();
+    uint8_t idx = 0;
+    // Check configuration.
+    if (configuration == NULL) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Check period.
+    if (uptime_seconds >= monitor_ctx.next_time_seconds) {
+        // Update next time.
+        monitor_ctx.next_time_seconds = uptime_seconds + (configuration->period_seconds);
+        // Turn analog front-end on once for all channels.
+        POWER_enable(configuration->power_requester_id, POWER_DOMAIN_ANALOG, LPTIM_DELAY_MODE_ACTIVE);
+        // Convert all channels with a single reference measurement.
+        analog_status = ANALOG_convert_channels(configuration->channels, configuration->number_of_channels, configuration->data);
+        ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
+        // Turn analog front-end off before executing actions.
+        POWER_disable(configuration->power_requester_id, POWER_DOMAIN_ANALOG);
+        // Hysteresis rules loop.
+        for (idx = 0; idx < (configuration->number_of_hysteresis); idx++) {
+            status = _MONITOR_apply_hysteresis(&(configuration->hysteresis[idx]));
+            if (status != NODE_SUCCESS) goto errors;
+        }
+        // Board specific processing.
+        if ((configuration->completion_callback) != NULL) {
+            status = configuration->completion_callback();
+            if (status != NODE_SUCCESS) goto errors;
+        }
+    }
+errors:
+    if (configuration != NULL) {
+        POWER_disable(configuration->power_requester_id, POWER_DOMAIN_ANALOG);
+        // Register next process.
+        SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, monitor_ctx.next_time_seconds);
+    }
+    return status;
+}
@@ -24,6 +24,7 @@
 #include "led.h"
 #include "lvrm.h"
 #include "lvrm_registers.h"
+#include "monitor.h"
 #include "mpmcm.h"
 #include "mpmcm_registers.h"
 #include "node_register.h"
@@ -35,6 +36,7 @@
 #include "rtc.h"
 #include "rrm.h"
 #include "rrm_registers.h"
+#include "scheduler.h"
 #include "sm.h"
 #include "sm_registers.h"
 #include "swreg.h"
@@ -44,6 +46,15 @@
 
 /*** NODE local macros ***/
 
+#define NODE_NVM_DIRTY_FLAGS_SIZE                           ((NODE_REGISTER_ADDRESS_LAST + 7) / 8)
+#define NODE_NVM_FLUSH_DELAY_SECONDS                        5
+
+#ifdef MPMCM
+#define NODE_NVM_UNA_REGISTERS_END                          (NVM_ADDRESS_UNA_REGISTERS + NODE_REGISTER_ADDRESS_LAST)
+#else
+#define NODE_NVM_UNA_REGISTERS_END                          (NVM_ADDRESS_UNA_REGISTERS + (NODE_REGISTER_ADDRESS_LAST * UNA_REGISTER_SIZE_BYTES))
+#endif
+
 #ifdef DSM_OUTPUT_CURRENT_INDICATOR
 #ifdef BCM
 #define NODE_OUTPUT_CURRENT_CHANNEL_INPUT_VOLTAGE           ANALOG_CHANNEL_SOURCE_VOLTAGE_MV
@@ -59,6 +70,11 @@
 #define NODE_OUTPUT_CURRENT_INDICATOR_BLINK_DURATION_US     2000000
 #endif
 
+/*** NODE compilation checks ***/
+
+_Static_assert(NODE_REGISTER_ADDRESS_LAST <= 0xFF, "NODE registers addresses must fit in 8 bits");
+_Static_assert(NODE_NVM_UNA_REGISTERS_END <= NVM_ADDRESS_ERROR_LOG, "NODE registers NVM area overlaps the error log area");
+
 /*** NODE local structures ***/
 
 #ifdef DSM_OUTPUT_CURRENT_INDICATOR
@@ -73,6 +89,10 @@ typedef struct {
 /*******************************************************************/
 typedef struct {
     uint8_t internal_access;
+    // NVM registers write-back.
+    uint8_t nvm_dirty_flags[NODE_NVM_DIRTY_FLAGS_SIZE];
+    uint8_t nvm_flush_pending;
+    uint32_t nvm_flush_time_seconds;
 #ifdef DSM_OUTPUT_CURRENT_INDICATOR
     uint32_t output_current_measurement_next_time_seconds;
     uint32_t output_current_indicator_next_time_seconds;
@@ -97,6 +117,8 @@ static const NODE_output_current_indicator_t NODE_OUTPUT_CURRENT_INDICATOR[NODE_
 
 static NODE_context_t node_ctx = {
     .internal_access = 0,
+    .nvm_flush_pending = 0,
+    .nvm_flush_time_seconds = 0,
 #ifdef DSM_OUTPUT_CURRENT_INDICATOR
     .output_current_measurement_next_time_seconds = 0,
     .output_current_indicator_next_time_seconds = 0,
@@ -107,6 +129,14 @@ static NODE_context_t node_ctx = {
 
 /*** NODE local functions ***/
 
+#if (defined DSM_LOAD_CONTROL) || (defined DSM_RGB_LED) || ((defined MPMCM) && (defined MPMCM_LINKY_TIC_ENABLE))
+/*******************************************************************/
+static void _NODE_driver_process_callback(void) {
+    // Wake-up node task to call the driver process function.
+    SCHEDULER_post_event(SCHEDULER_TASK_NODE);
+}
+#endif
+
 #ifdef DSM_OUTPUT_CURRENT_INDICATOR
 /*******************************************************************/
 static NODE_status_t _NODE_output_current_measurement(void) {
@@ -192,18 +222,29 @@ static NODE_status_t _NODE_store_register(uint8_t reg_addr) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
     NVM_status_t nvm_status = NVM_SUCCESS;
+    uint32_t reg_value = NODE_RAM_REGISTER[reg_addr];
 #ifdef MPMCM
-    nvm_status = NVM_write_word((NVM_ADDRESS_UNA_REGISTERS + reg_addr), NODE_RAM_REGISTER[reg_addr]);
+    uint32_t nvm_word = 0;
+    // Program only if the value differs from the NVM content.
+    nvm_status = NVM_read_word((NVM_ADDRESS_UNA_REGISTERS + reg_addr), &nvm_word);
+    NVM_exit_error(NODE_ERROR_BASE_NVM);
+    if (nvm_word == reg_value) goto errors;
+    nvm_status = NVM_write_word((NVM_ADDRESS_UNA_REGISTERS + reg_addr), reg_value);
     NVM_exit_error(NODE_ERROR_BASE_NVM);
 #else
+    uint8_t reg_byte = 0;
     uint8_t nvm_byte = 0;
     uint8_t idx = 0;
     // Byte loop.
     for (idx = 0; idx < UNA_REGISTER_SIZE_BYTES; idx++) {
         // Compute byte.
-        nvm_byte = (uint8_t) (((NODE_RAM_REGISTER[reg_addr]) >> (idx << 3)) & 0x000000FF);
+        reg_byte = (uint8_t) ((reg_value >> (idx << 3)) & 0x000000FF);
+        // Program only the bytes which differ from the NVM content.
+        nvm_status = NVM_read_byte((NVM_ADDRESS_UNA_REGISTERS + (reg_addr << 2) + idx), &nvm_byte);
+        NVM_exit_error(NODE_ERROR_BASE_NVM);
+        if (nvm_byte == reg_byte) continue;
         // Write NVM.
-        nvm_status = NVM_write_byte((NVM_ADDRESS_UNA_REGISTERS + (reg_addr << 2) + idx), nvm_byte);
+        nvm_status = NVM_write_byte((NVM_ADDRESS_UNA_REGISTERS + (reg_addr << 2) + idx), reg_byte);
         NVM_exit_error(NODE_ERROR_BASE_NVM);
     }
 #endif
@@ -211,6 +252,17 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+static void _NODE_set_nvm_dirty_flag(uint8_t reg_addr) {
+    // Set dirty flag.
+    // Note: unchanged values are filtered by the flush which compares the register with the NVM content.
+    node_ctx.nvm_dirty_flags[reg_addr >> 3] |= (0b1 << (reg_addr & 0x07));
+    // Postpone flush to group consecutive writes.
+    node_ctx.nvm_flush_time_seconds = (RTC_get_uptime_seconds() + NODE_NVM_FLUSH_DELAY_SECONDS);
+    node_ctx.nvm_flush_pending = 1;
+    SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, node_ctx.nvm_flush_time_seconds);
+}
+
 /*******************************************************************/
 static void _NODE_refresh_register(uint8_t reg_addr) {
     // Refresh registers.
@@ -247,6 +299,9 @@ NODE_status_t NODE_init(void) {
     NODE_status_t node_status = NODE_SUCCESS;
     uint32_t init_reg_value = 0;
     uint8_t reg_addr = 0;
+#ifdef DSM_LOAD_CONTROL
+    LOAD_status_t load_status = LOAD_SUCCESS;
+#endif
 #ifdef DSM_RGB_LED
     LED_status_t led_status = LED_SUCCESS;
 #endif
@@ -266,7 +321,11 @@ NODE_status_t NODE_init(void) {
     node_ctx.input_voltage_mv = 0;
     node_ctx.output_current_ua = 0;
 #endif
-    // Init registers.
+    // Init NVM write-back.
+    for (reg_addr = 0; reg_addr < NODE_NVM_DIRTY_FLAGS_SIZE; reg_addr++) {
+        node_ctx.nvm_dirty_flags[reg_addr] = 0;
+    }
+    // Init registers in a single pass.
     for (reg_addr = 0; reg_addr < NODE_REGISTER_ADDRESS_LAST; reg_addr++) {
         // Check reset value.
         switch (NODE_REGISTER[reg_addr].reset_value) {
@@ -294,10 +353,11 @@ NODE_status_t NODE_init(void) {
         NODE_stack_error(ERROR_BASE_NODE);
     }
 #ifdef DSM_LOAD_CONTROL
-    LOAD_init();
+    load_status = LOAD_init(&_NODE_driver_process_callback);
+    LOAD_stack_error(ERROR_BASE_NODE + NODE_ERROR_BASE_LOAD);
 #endif
 #ifdef DSM_RGB_LED
-    led_status = LED_init();
+    led_status = LED_init(&_NODE_driver_process_callback);
     LED_stack_error(ERROR_BASE_LED);
 #endif
 #ifdef MPMCM
@@ -306,12 +366,18 @@ NODE_status_t NODE_init(void) {
     MEASURE_stack_error(ERROR_BASE_MEASURE);
 #endif
 #ifdef MPMCM_LINKY_TIC_ENABLE
-    tic_status = TIC_init();
+    tic_status = TIC_init(&_NODE_driver_process_callback);
     TIC_stack_error(ERROR_BASE_TIC);
 #endif
 #endif
     // Init specific driver.
     status = NODE_INIT();
+#ifdef NODE_MONITOR_CONFIGURATION
+    MONITOR_init(&NODE_MONITOR_CONFIGURATION);
+#endif
+    // Store initial values.
+    node_status = NODE_commit_registers();
+    NODE_stack_error(ERROR_BASE_NODE);
     // Disable internal access.
     node_ctx.internal_access = 0;
     return status;
@@ -321,6 +387,7 @@ NODE_status_t NODE_init(void) {
 NODE_status_t NODE_de_init(void) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
+    NODE_status_t node_status = NODE_SUCCESS;
 #ifdef MPMCM
 #ifdef MPMCM_ANALOG_MEASURE_ENABLE
     MEASURE_status_t measure_status = MEASURE_SUCCESS;
@@ -344,6 +411,9 @@ NODE_status_t NODE_de_init(void) {
     led_status = LED_de_init();
     LED_stack_error(ERROR_BASE_NODE + NODE_ERROR_BASE_LED);
 #endif
+    // Store pending registers.
+    node_status = NODE_commit_registers();
+    NODE_stack_error(ERROR_BASE_NODE);
     return status;
 }
 
@@ -351,45 +421,70 @@ NODE_status_t NODE_de_init(void) {
 NODE_status_t NODE_process(void) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
-#if (((defined LVRM) && (defined LVRM_MODE_BMS)) || (defined BPSM) || (defined BCM) || (defined DSM_OUTPUT_CURRENT_INDICATOR))
     NODE_status_t node_status = NODE_SUCCESS;
-#endif
 #if ((defined DSM_RGB_LED) && !(defined MPMCM))
     LED_status_t led_status = LED_SUCCESS;
 #endif
+#if ((defined LVRM) && (defined HW2_0))
+    LOAD_status_t load_status = LOAD_SUCCESS;
+#endif
+#if ((defined MPMCM) && (defined MPMCM_ANALOG_MEASURE_ENABLE))
+    MEASURE_status_t measure_status = MEASURE_SUCCESS;
+#endif
 #if ((defined MPMCM) && (defined MPMCM_LINKY_TIC_ENABLE))
     TIC_status_t tic_status = TIC_SUCCESS;
 #endif
     // Read RTRG bit.
     if (SWREG_read_field(NODE_RAM_REGISTER[COMMON_REGISTER_ADDRESS_CONTROL_0], COMMON_REGISTER_CONTROL_0_MASK_RTRG) != 0) {
+        // Store pending registers before reset.
+        node_status = NODE_commit_registers();
+        NODE_stack_error(ERROR_BASE_NODE);
         // Reset MCU.
         PWR_software_reset();
     }
-#if ((defined LVRM) && (defined LVRM_MODE_BMS))
-    status = LVRM_bms_process();
+    // Store pending registers after idle delay.
+    if ((node_ctx.nvm_flush_pending != 0) && (RTC_get_uptime_seconds() >= node_ctx.nvm_flush_time_seconds)) {
+        node_status = NODE_commit_registers();
+        NODE_stack_error(ERROR_BASE_NODE);
+    }
+#if ((defined LVRM) && (defined HW2_0))
+    // Process relay sequence.
+    load_status = LOAD_process();
+    LOAD_stack_error(ERROR_BASE_NODE + NODE_ERROR_BASE_LOAD);
+#endif
+#ifdef NODE_MONITOR_CONFIGURATION
+    // Process periodic measurements.
+    node_status = MONITOR_process();
     NODE_stack_error(ERROR_BASE_NODE);
 #endif
-#ifdef BPSM
-    node_status = BPSM_low_voltage_detector_process();
-    NODE_stack_error(ERROR_BASE_NODE);
-#ifndef BPSM_CHARGE_CONTROL_FORCED_HARDWARE
+#if ((defined BPSM) && !(defined BPSM_CHARGE_CONTROL_FORCED_HARDWARE))
     node_status = BPSM_charge_process();
     NODE_stack_error(ERROR_BASE_NODE);
 #endif
+#ifdef GPSM
+    // Process GPS acquisitions.
+    node_status = GPSM_process();
+    NODE_stack_error(ERROR_BASE_NODE);
+#endif
+#if ((defined UHFM) && (defined UHFM_UPLINK_QUEUE_DEPTH))
+    // Send queued Sigfox messages.
+    node_status = UHFM_process();
+    NODE_stack_error(ERROR_BASE_NODE);
+#endif
+#if ((defined MPMCM) && (defined MPMCM_ANALOG_MEASURE_ENABLE))
+    // Process analog measurements.
+    measure_status = MEASURE_process();
+    MEASURE_stack_error(ERROR_BASE_MEASURE);
 #endif
 #if ((defined MPMCM) && (defined MPMCM_LINKY_TIC_ENABLE))
     // Process TIC interface.
     tic_status = TIC_process();
     TIC_stack_error(ERROR_BASE_TIC);
 #endif
-#ifdef BCM
-    node_status = BCM_low_voltage_detector_process();
-    NODE_stack_error(ERROR_BASE_NODE);
-#ifndef BCM_CHARGE_CONTROL_FORCED_HARDWARE
+#if ((defined BCM) && !(defined BCM_CHARGE_CONTROL_FORCED_HARDWARE))
     node_status = BCM_charge_process();
     NODE_stack_error(ERROR_BASE_NODE);
 #endif
-#endif
 #if ((defined DSM_RGB_LED) && !(defined MPMCM))
     led_status = LED_process();
     LED_stack_error(ERROR_BASE_LED);
@@ -411,7 +506,13 @@ NODE_status_t NODE_process(void) {
         node_status = _NODE_output_current_indicator();
         NODE_stack_error(ERROR_BASE_NODE);
     }
+    SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, node_ctx.output_current_measurement_next_time_seconds);
+    SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, node_ctx.output_current_indicator_next_time_seconds);
 #endif
+    // Register next NVM flush.
+    if (node_ctx.nvm_flush_pending != 0) {
+        SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, node_ctx.nvm_flush_time_seconds);
+    }
     return status;
 }
 
@@ -449,6 +550,18 @@ NODE_state_t NODE_get_state(void) {
 #ifdef DSM_OUTPUT_CURRENT_INDICATOR
     state = (LED_get_state() == LED_STATE_OFF) ? NODE_STATE_IDLE : NODE_STATE_RUNNING;
 #endif
+#if ((defined LVRM) && (defined HW2_0))
+    // Relay sequence timer requires sleep mode.
+    if (LOAD_is_switching() != 0) {
+        state = NODE_STATE_RUNNING;
+    }
+#endif
+#ifdef GPSM
+    // GPS UART reception requires sleep mode.
+    if (GPS_get_acquisition_state() == GPS_ACQUISITION_STATE_RUNNING) {
+        state = NODE_STATE_RUNNING;
+    }
+#endif
 #endif
     return state;
 }
@@ -478,10 +591,9 @@ NODE_status_t NODE_write_register(uint8_t reg_addr, uint32_t reg_value, uint32_t
     // Secure register.
     node_status = _NODE_secure_register(reg_addr, NODE_RAM_REGISTER[reg_addr], &safe_reg_mask, &(NODE_RAM_REGISTER[reg_addr]));
     NODE_stack_error(ERROR_BASE_NODE);
-    // Store value in NVM if needed.
+    // Mark register to be stored in NVM if needed.
     if (NODE_REGISTER[reg_addr].reset_value == UNA_REGISTER_RESET_VALUE_NVM) {
-        node_status = _NODE_store_register(reg_addr);
-        NODE_stack_error(ERROR_BASE_NODE);
+        _NODE_set_nvm_dirty_flag(reg_addr);
     }
     // Check actions.
     if (node_ctx.internal_access == 0) {
@@ -492,6 +604,32 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+NODE_status_t NODE_commit_registers(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    uint8_t reg_addr = 0;
+    // Registers loop.
+    for (reg_addr = 0; reg_addr < NODE_REGISTER_ADDRESS_LAST; reg_addr++) {
+        // Skip clean registers.
+        if ((node_ctx.nvm_dirty_flags[reg_addr >> 3] & (0b1 << (reg_addr & 0x07))) == 0) continue;
+        // Write NVM.
+        status = _NODE_store_register(reg_addr);
+        if (status != NODE_SUCCESS) goto errors;
+        // Clear dirty flag.
+        node_ctx.nvm_dirty_flags[reg_addr >> 3] &= ~(0b1 << (reg_addr & 0x07));
+    }
+    // Clear flag.
+    node_ctx.nvm_flush_pending = 0;
+    return status;
+errors:
+    // Retry later.
+    node_ctx.nvm_flush_pending = 1;
+    node_ctx.nvm_flush_time_seconds = (RTC_get_uptime_seconds() + NODE_NVM_FLUSH_DELAY_SECONDS);
+    SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, node_ctx.nvm_flush_time_seconds);
+    return status;
+}
+
 /*******************************************************************/
 NODE_status_t NODE_read_register(uint8_t reg_addr, uint32_t* reg_value) {
     // Local variables.
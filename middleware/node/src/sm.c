@@ -42,6 +42,21 @@
 #define SM_FLAG_DIGF    0b0
 #endif
 
+#ifdef SM_AIN_ENABLE
+#define SM_NUMBER_OF_AIN    4
+#endif
+
+/*** SM local global variables ***/
+
+#ifdef SM_AIN_ENABLE
+static const ANALOG_channel_t SM_AIN_CHANNEL_LIST[SM_NUMBER_OF_AIN] = {
+    ANALOG_CHANNEL_AIN0_VOLTAGE_MV,
+    ANALOG_CHANNEL_AIN1_VOLTAGE_MV,
+    ANALOG_CHANNEL_AIN2_VOLTAGE_MV,
+    ANALOG_CHANNEL_AIN3_VOLTAGE_MV
+};
+#endif
+
 /*** SM functions ***/
 
 /*******************************************************************/
@@ -109,7 +124,7 @@ NODE_status_t SM_mtrg_callback(void) {
     ANALOG_status_t analog_status = ANALOG_SUCCESS;
     uint32_t* reg_analog_data_1_ptr = &(NODE_RAM_REGISTER[SM_REGISTER_ADDRESS_ANALOG_DATA_1]);
     uint32_t* reg_analog_data_2_ptr = &(NODE_RAM_REGISTER[SM_REGISTER_ADDRESS_ANALOG_DATA_2]);
-    int32_t adc_data = 0;
+    int32_t ainx_voltage_mv[SM_NUMBER_OF_AIN];
 #endif
 #ifdef SM_DIO_ENABLE
     DIGITAL_status_t digital_status = DIGITAL_SUCCESS;
@@ -124,33 +139,31 @@ NODE_status_t SM_mtrg_callback(void) {
 #endif
 #if ((defined SM_AIN_ENABLE) || (defined SM_DIO_ENABLE) ||  (defined SM_DIGITAL_SENSORS_ENABLE))
     uint32_t unused_mask = 0;
+#endif
+    // Turn digital front-end and sensors on together, so that a single power on delay covers both domains.
+#ifdef SM_DIO_ENABLE
+    POWER_request(POWER_REQUESTER_ID_SM, POWER_DOMAIN_DIGITAL);
+#endif
+#ifdef SM_DIGITAL_SENSORS_ENABLE
+    POWER_request(POWER_REQUESTER_ID_SM, POWER_DOMAIN_SENSORS);
 #endif
 #ifdef SM_AIN_ENABLE
     // Reset data.
     (*reg_analog_data_1_ptr) = NODE_REGISTER[SM_REGISTER_ADDRESS_ANALOG_DATA_1].error_value;
     (*reg_analog_data_2_ptr) = NODE_REGISTER[SM_REGISTER_ADDRESS_ANALOG_DATA_2].error_value;
-    // AIN0.
-    analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_AIN0_VOLTAGE_MV, &adc_data);
-    ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
-    SWREG_write_field(reg_analog_data_1_ptr, &unused_mask, UNA_convert_mv(adc_data), SM_REGISTER_ANALOG_DATA_1_MASK_AIN0_VOLTAGE);
-    // AIN0.
-    analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_AIN1_VOLTAGE_MV, &adc_data);
-    ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
-    SWREG_write_field(reg_analog_data_1_ptr, &unused_mask, UNA_convert_mv(adc_data), SM_REGISTER_ANALOG_DATA_1_MASK_AIN1_VOLTAGE);
-    // AIN2.
-    analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_AIN2_VOLTAGE_MV, &adc_data);
-    ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
-    SWREG_write_field(reg_analog_data_2_ptr, &unused_mask, UNA_convert_mv(adc_data), SM_REGISTER_ANALOG_DATA_2_MASK_AIN2_VOLTAGE);
-    // AIN3.
-    analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_AIN3_VOLTAGE_MV, &adc_data);
+    // Convert all analog inputs with the MCU voltage reference measured by the common callback.
+    analog_status = ANALOG_convert_channels(SM_AIN_CHANNEL_LIST, SM_NUMBER_OF_AIN, ainx_voltage_mv);
     ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
-    SWREG_write_field(reg_analog_data_2_ptr, &unused_mask, UNA_convert_mv(adc_data), SM_REGISTER_ANALOG_DATA_2_MASK_AIN3_VOLTAGE);
+    SWREG_write_field(reg_analog_data_1_ptr, &unused_mask, UNA_convert_mv(ainx_voltage_mv[0]), SM_REGISTER_ANALOG_DATA_1_MASK_AIN0_VOLTAGE);
+    SWREG_write_field(reg_analog_data_1_ptr, &unused_mask, UNA_convert_mv(ainx_voltage_mv[1]), SM_REGISTER_ANALOG_DATA_1_MASK_AIN1_VOLTAGE);
+    SWREG_write_field(reg_analog_data_2_ptr, &unused_mask, UNA_convert_mv(ainx_voltage_mv[2]), SM_REGISTER_ANALOG_DATA_2_MASK_AIN2_VOLTAGE);
+    SWREG_write_field(reg_analog_data_2_ptr, &unused_mask, UNA_convert_mv(ainx_voltage_mv[3]), SM_REGISTER_ANALOG_DATA_2_MASK_AIN3_VOLTAGE);
 #endif
 #ifdef SM_DIO_ENABLE
     // Reset data.
     (*reg_digital_data_1_ptr) = NODE_REGISTER[SM_REGISTER_ADDRESS_DIGITAL_DATA].error_value;
-    // Turn digital front-end on.
-    POWER_enable(POWER_REQUESTER_ID_SM, POWER_DOMAIN_DIGITAL, LPTIM_DELAY_MODE_SLEEP);
+    // Wait for digital front-end and sensors.
+    POWER_wait(LPTIM_DELAY_MODE_SLEEP);
     // DIO0.
     digital_status = DIGITAL_read_channel(DIGITAL_CHANNEL_DIO0, &state);
     DIGITAL_exit_error(NODE_ERROR_BASE_DIGITAL);
@@ -171,8 +184,8 @@ NODE_status_t SM_mtrg_callback(void) {
 #ifdef SM_DIGITAL_SENSORS_ENABLE
     // Reset data.
     (*reg_analog_data_3_ptr) = NODE_REGISTER[SM_REGISTER_ADDRESS_ANALOG_DATA_3].error_value;
-    // Turn sensors on.
-    POWER_enable(POWER_REQUESTER_ID_SM, POWER_DOMAIN_SENSORS, LPTIM_DELAY_MODE_STOP);
+    // Wait for sensors.
+    POWER_wait(LPTIM_DELAY_MODE_STOP);
     // Temperature and humidity.
     sht3x_status = SHT3X_get_temperature_humidity(I2C_ADDRESS_SHT30, &temperature_tenth_degrees, &humidity_percent);
     SHT3X_exit_error(NODE_ERROR_BASE_SHT3X);
@@ -24,6 +24,8 @@
 #include "nvm.h"
 #include "nvm_address.h"
 #include "rfe.h"
+#include "rtc.h"
+#include "scheduler.h"
 #include "sigfox_ep_addon_rfp_api.h"
 #include "sigfox_ep_api.h"
 #include "sigfox_rc.h"
@@ -88,6 +90,25 @@
 #define UHFM_ADC_MEASUREMENTS_RF_FREQUENCY_HZ   860000000
 #define UHFM_ADC_RADIO_STABILIZATION_DELAY_MS   100
 
+#define UHFM_UPLINK_FLAG_SBF                    0b01
+#define UHFM_UPLINK_FLAG_SCMF                   0b10
+#define UHFM_UPLINK_SIZE_BYTES                  (8 + SIGFOX_UL_PAYLOAD_MAX_SIZE_BYTES)
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+#define UHFM_UPLINK_QUEUE_NVM_MARKER            0xA5
+#define UHFM_UPLINK_QUEUE_NVM_END               (NVM_ADDRESS_UHFM_UPLINK_QUEUE + (UHFM_UPLINK_QUEUE_DEPTH * UHFM_UPLINK_SIZE_BYTES))
+#define UHFM_UPLINK_QUEUE_INDEX_NONE            0xFF
+#define UHFM_UPLINK_QUEUE_RETRY_MAX             3
+#define UHFM_UPLINK_QUEUE_RETRY_DELAY_SECONDS   30
+#endif
+
+/*** UHFM compilation checks ***/
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+_Static_assert(UHFM_UPLINK_QUEUE_DEPTH < UHFM_UPLINK_QUEUE_INDEX_NONE, "UHFM uplink queue depth must fit in 8 bits");
+_Static_assert(UHFM_UPLINK_QUEUE_NVM_END <= 0x400, "UHFM uplink queue exceeds the EEPROM size");
+#endif
+
 /*** UHFM local structures ***/
 
 /*******************************************************************/
@@ -102,6 +123,43 @@ typedef enum {
     UHFM_SIGFOX_RC_LAST
 } UHFM_sigfox_rc_t;
 
+/*******************************************************************/
+typedef enum {
+    UHFM_UPLINK_PRIORITY_CONTROL = 0,
+    UHFM_UPLINK_PRIORITY_APPLICATION,
+    UHFM_UPLINK_PRIORITY_BIDIRECTIONAL,
+    UHFM_UPLINK_PRIORITY_LAST
+} UHFM_uplink_priority_t;
+
+/*******************************************************************/
+typedef union {
+    uint8_t all[UHFM_UPLINK_SIZE_BYTES];
+    struct {
+        uint8_t marker;
+        uint8_t priority;
+        uint16_t sequence;
+        uint8_t retry_count;
+        uint8_t message_type;
+        uint8_t flags;
+        uint8_t ul_payload_size;
+        uint8_t ul_payload[SIGFOX_UL_PAYLOAD_MAX_SIZE_BYTES];
+    } __attribute__((packed));
+} UHFM_uplink_t;
+
+/*******************************************************************/
+typedef struct {
+    uint8_t cwen_flag;
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+    UHFM_uplink_t uplink_queue[UHFM_UPLINK_QUEUE_DEPTH];
+    uint32_t uplink_queue_retry_time_seconds[UHFM_UPLINK_QUEUE_DEPTH];
+    uint16_t uplink_queue_sequence;
+    int32_t uplink_queue_last_queued_id;
+    int32_t uplink_queue_last_sent_id;
+    uint32_t uplink_queue_drop_count;
+    uint32_t uplink_queue_duplicate_count;
+#endif
+} UHFM_context_t;
+
 /*** UHFM local global variables ***/
 
 static const SIGFOX_rc_t* UHFM_SIGFOX_RC[UHFM_SIGFOX_RC_LAST] = {
@@ -142,7 +200,16 @@ static const SIGFOX_rc_t* UHFM_SIGFOX_RC[UHFM_SIGFOX_RC_LAST] = {
 #endif
 };
 
-static uint8_t uhfm_cwen_flag = 0;
+static UHFM_context_t uhfm_ctx = {
+    .cwen_flag = 0,
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+    .uplink_queue_sequence = 0,
+    .uplink_queue_last_queued_id = UHFM_UPLINK_QUEUE_ID_NONE,
+    .uplink_queue_last_sent_id = UHFM_UPLINK_QUEUE_ID_NONE,
+    .uplink_queue_drop_count = 0,
+    .uplink_queue_duplicate_count = 0
+#endif
+};
 
 /*** UHFM local functions ***/
 
@@ -159,7 +226,7 @@ static NODE_status_t _UHFM_is_radio_free(void) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
     // Compare state.
-    if (POWER_get_state(POWER_DOMAIN_RADIO) != 0) {
+    if (POWER_get_state(POWER_DOMAIN_RADIO) != POWER_STATE_OFF) {
         status = NODE_ERROR_RADIO_STATE;
         goto errors;
     }
@@ -208,7 +275,7 @@ errors:
         RF_API_de_init();
         RF_API_sleep();
         // Update local flag.
-        uhfm_cwen_flag = 0;
+        uhfm_ctx.cwen_flag = 0;
     }
     return status;
 }
@@ -274,7 +341,298 @@ errors:
 }
 
 /*******************************************************************/
-static NODE_status_t _UHFM_strg_callback(void) {
+static void _UHFM_read_uplink(UHFM_uplink_t* uplink) {
+    // Local variables.
+    uint32_t reg_control_1 = NODE_RAM_REGISTER[UHFM_REGISTER_ADDRESS_CONTROL_1];
+    uint8_t idx = 0;
+    // Reset message.
+    for (idx = 0; idx < UHFM_UPLINK_SIZE_BYTES; idx++) {
+        uplink->all[idx] = 0;
+    }
+    // Read message parameters.
+    uplink->message_type = (uint8_t) SWREG_read_field(reg_control_1, UHFM_REGISTER_CONTROL_1_MASK_SIGFOX_MSGT);
+    uplink->ul_payload_size = (uint8_t) SWREG_read_field(reg_control_1, UHFM_REGISTER_CONTROL_1_MASK_SIGFOX_UL_PAYLOAD_SIZE);
+    if ((uplink->ul_payload_size) > SIGFOX_UL_PAYLOAD_MAX_SIZE_BYTES) {
+        uplink->ul_payload_size = SIGFOX_UL_PAYLOAD_MAX_SIZE_BYTES;
+    }
+    if (SWREG_read_field(reg_control_1, UHFM_REGISTER_CONTROL_1_MASK_SBF) != 0) {
+        uplink->flags |= UHFM_UPLINK_FLAG_SBF;
+    }
+#ifdef SIGFOX_EP_CONTROL_KEEP_ALIVE_MESSAGE
+    if (SWREG_read_field(reg_control_1, UHFM_REGISTER_CONTROL_1_MASK_SCMF) != 0) {
+        uplink->flags |= UHFM_UPLINK_FLAG_SCMF;
+    }
+#endif
+    // Read UL payload.
+    SWREG_read_byte_array(uplink->ul_payload, uplink->ul_payload_size, &(NODE_RAM_REGISTER[UHFM_REGISTER_ADDRESS_SIGFOX_UL_PAYLOAD_0]));
+    // Messages waiting for a downlink are sent first, keep alive messages last.
+    if (((uplink->flags) & UHFM_UPLINK_FLAG_SCMF) != 0) {
+        uplink->priority = UHFM_UPLINK_PRIORITY_CONTROL;
+    }
+    else if (((uplink->flags) & UHFM_UPLINK_FLAG_SBF) != 0) {
+        uplink->priority = UHFM_UPLINK_PRIORITY_BIDIRECTIONAL;
+    }
+    else {
+        uplink->priority = UHFM_UPLINK_PRIORITY_APPLICATION;
+    }
+}
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static NODE_status_t _UHFM_uplink_queue_store(uint8_t queue_idx, uint8_t* field_ptr, uint8_t field_size_bytes) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t offset = (uint8_t) (field_ptr - &(uhfm_ctx.uplink_queue[queue_idx].all[0]));
+    uint8_t idx = 0;
+    // Byte loop.
+    for (idx = 0; idx < field_size_bytes; idx++) {
+        nvm_status = NVM_write_byte((NVM_ADDRESS_UHFM_UPLINK_QUEUE + (queue_idx * UHFM_UPLINK_SIZE_BYTES) + offset + idx), field_ptr[idx]);
+        NVM_exit_error(NODE_ERROR_BASE_NVM);
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static NODE_status_t _UHFM_uplink_queue_load(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    UHFM_uplink_t* uplink_ptr = NULL;
+    uint8_t sequence_valid = 0;
+    uint8_t queue_idx = 0;
+    uint8_t idx = 0;
+    // Reset sequence.
+    uhfm_ctx.uplink_queue_sequence = 0;
+    // Entries loop.
+    for (queue_idx = 0; queue_idx < UHFM_UPLINK_QUEUE_DEPTH; queue_idx++) {
+        uplink_ptr = &(uhfm_ctx.uplink_queue[queue_idx]);
+        // Recovered messages can be sent at once.
+        uhfm_ctx.uplink_queue_retry_time_seconds[queue_idx] = 0;
+        // Read entry.
+        for (idx = 0; idx < UHFM_UPLINK_SIZE_BYTES; idx++) {
+            nvm_status = NVM_read_byte((NVM_ADDRESS_UHFM_UPLINK_QUEUE + (queue_idx * UHFM_UPLINK_SIZE_BYTES) + idx), &(uplink_ptr->all[idx]));
+            NVM_exit_error(NODE_ERROR_BASE_NVM);
+        }
+        // Discard erased or corrupted entries.
+        if (((uplink_ptr->marker) != UHFM_UPLINK_QUEUE_NVM_MARKER) || ((uplink_ptr->priority) >= UHFM_UPLINK_PRIORITY_LAST) || ((uplink_ptr->ul_payload_size) > SIGFOX_UL_PAYLOAD_MAX_SIZE_BYTES)) {
+            uplink_ptr->marker = 0;
+            continue;
+        }
+        // Resume sequence after the most recent entry.
+        if ((sequence_valid == 0) || (((int16_t) ((uplink_ptr->sequence) - uhfm_ctx.uplink_queue_sequence)) >= 0)) {
+            uhfm_ctx.uplink_queue_sequence = (uint16_t) ((uplink_ptr->sequence) + 1);
+            sequence_valid = 1;
+        }
+    }
+errors:
+    return status;
+}
+#endif
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static uint8_t _UHFM_uplink_queue_is_before(UHFM_uplink_t* uplink_1, UHFM_uplink_t* uplink_2) {
+    // Higher priority first, then oldest sequence.
+    if ((uplink_1->priority) != (uplink_2->priority)) {
+        return (((uplink_1->priority) > (uplink_2->priority)) ? 1 : 0);
+    }
+    return ((((int16_t) ((uplink_1->sequence) - (uplink_2->sequence))) < 0) ? 1 : 0);
+}
+#endif
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static uint8_t _UHFM_uplink_queue_is_victim_before(UHFM_uplink_t* uplink_1, UHFM_uplink_t* uplink_2) {
+    // Lower priority first, then oldest sequence.
+    if ((uplink_1->priority) != (uplink_2->priority)) {
+        return (((uplink_1->priority) < (uplink_2->priority)) ? 1 : 0);
+    }
+    return ((((int16_t) ((uplink_1->sequence) - (uplink_2->sequence))) < 0) ? 1 : 0);
+}
+#endif
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static uint8_t _UHFM_uplink_queue_is_duplicate(UHFM_uplink_t* uplink_1, UHFM_uplink_t* uplink_2) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Compare message parameters.
+    if (((uplink_1->message_type) != (uplink_2->message_type)) || ((uplink_1->flags) != (uplink_2->flags)) || ((uplink_1->ul_payload_size) != (uplink_2->ul_payload_size))) {
+        return 0;
+    }
+    // Compare payload.
+    for (idx = 0; idx < (uplink_1->ul_payload_size); idx++) {
+        if ((uplink_1->ul_payload[idx]) != (uplink_2->ul_payload[idx])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+#endif
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static uint8_t _UHFM_uplink_queue_get_depth(void) {
+    // Local variables.
+    uint8_t depth = 0;
+    uint8_t queue_idx = 0;
+    // Count valid entries.
+    for (queue_idx = 0; queue_idx < UHFM_UPLINK_QUEUE_DEPTH; queue_idx++) {
+        if ((uhfm_ctx.uplink_queue[queue_idx].marker) == UHFM_UPLINK_QUEUE_NVM_MARKER) {
+            depth++;
+        }
+    }
+    return depth;
+}
+#endif
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static NODE_status_t _UHFM_uplink_queue_push(UHFM_uplink_t* uplink, uint8_t* uplink_queue_idx) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    UHFM_uplink_t* uplink_ptr = NULL;
+    uint8_t free_idx = UHFM_UPLINK_QUEUE_INDEX_NONE;
+    uint8_t victim_idx = UHFM_UPLINK_QUEUE_INDEX_NONE;
+    uint8_t queue_idx = 0;
+    // Reset output index.
+    (*uplink_queue_idx) = UHFM_UPLINK_QUEUE_INDEX_NONE;
+    // Entries loop.
+    for (queue_idx = 0; queue_idx < UHFM_UPLINK_QUEUE_DEPTH; queue_idx++) {
+        uplink_ptr = &(uhfm_ctx.uplink_queue[queue_idx]);
+        // Check free entry.
+        if ((uplink_ptr->marker) != UHFM_UPLINK_QUEUE_NVM_MARKER) {
+            if (free_idx == UHFM_UPLINK_QUEUE_INDEX_NONE) {
+                free_idx = queue_idx;
+            }
+            continue;
+        }
+        // Suppress duplicates of pending messages.
+        if (_UHFM_uplink_queue_is_duplicate(uplink, uplink_ptr) != 0) {
+            uhfm_ctx.uplink_queue_duplicate_count++;
+            uhfm_ctx.uplink_queue_last_queued_id = (int32_t) (uplink_ptr->sequence);
+            (*uplink_queue_idx) = queue_idx;
+            goto errors;
+        }
+        // Select the oldest entry of the lowest priority as victim.
+        if ((victim_idx == UHFM_UPLINK_QUEUE_INDEX_NONE) || (_UHFM_uplink_queue_is_victim_before(uplink_ptr, &(uhfm_ctx.uplink_queue[victim_idx])) != 0)) {
+            victim_idx = queue_idx;
+        }
+    }
+    // Check if queue is full.
+    if (free_idx == UHFM_UPLINK_QUEUE_INDEX_NONE) {
+        // Count dropped message.
+        uhfm_ctx.uplink_queue_drop_count++;
+        // Reject new message if all pending messages have a higher priority.
+        if ((victim_idx == UHFM_UPLINK_QUEUE_INDEX_NONE) || ((uhfm_ctx.uplink_queue[victim_idx].priority) > (uplink->priority))) {
+            uhfm_ctx.uplink_queue_last_queued_id = UHFM_UPLINK_QUEUE_ID_NONE;
+            status = NODE_ERROR_RADIO_STATE;
+            goto errors;
+        }
+        // Drop victim.
+        free_idx = victim_idx;
+        uhfm_ctx.uplink_queue[free_idx].marker = 0;
+        status = _UHFM_uplink_queue_store(free_idx, &(uhfm_ctx.uplink_queue[free_idx].marker), 1);
+        if (status != NODE_SUCCESS) goto errors;
+    }
+    // Fill entry.
+    uplink->marker = 0;
+    uplink->sequence = uhfm_ctx.uplink_queue_sequence;
+    uplink->retry_count = 0;
+    uhfm_ctx.uplink_queue[free_idx] = (*uplink);
+    uhfm_ctx.uplink_queue_retry_time_seconds[free_idx] = 0;
+    uhfm_ctx.uplink_queue_last_queued_id = (int32_t) (uplink->sequence);
+    uhfm_ctx.uplink_queue_sequence++;
+    // Store entry and write marker at last to validate it.
+    uplink_ptr = &(uhfm_ctx.uplink_queue[free_idx]);
+    status = _UHFM_uplink_queue_store(free_idx, &(uplink_ptr->all[1]), (UHFM_UPLINK_SIZE_BYTES - 1));
+    if (status != NODE_SUCCESS) goto errors;
+    uplink_ptr->marker = UHFM_UPLINK_QUEUE_NVM_MARKER;
+    status = _UHFM_uplink_queue_store(free_idx, &(uplink_ptr->marker), 1);
+    if (status != NODE_SUCCESS) goto errors;
+    (*uplink_queue_idx) = free_idx;
+errors:
+    return status;
+}
+#endif
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static uint8_t _UHFM_uplink_queue_get_next_index(uint32_t uptime_seconds) {
+    // Local variables.
+    uint8_t next_idx = UHFM_UPLINK_QUEUE_INDEX_NONE;
+    uint8_t queue_idx = 0;
+    // Entries loop.
+    for (queue_idx = 0; queue_idx < UHFM_UPLINK_QUEUE_DEPTH; queue_idx++) {
+        if ((uhfm_ctx.uplink_queue[queue_idx].marker) != UHFM_UPLINK_QUEUE_NVM_MARKER) continue;
+        // Skip entries waiting for their retry delay.
+        if (uptime_seconds < uhfm_ctx.uplink_queue_retry_time_seconds[queue_idx]) continue;
+        // Select the first entry in sending order.
+        if ((next_idx == UHFM_UPLINK_QUEUE_INDEX_NONE) || (_UHFM_uplink_queue_is_before(&(uhfm_ctx.uplink_queue[queue_idx]), &(uhfm_ctx.uplink_queue[next_idx])) != 0)) {
+            next_idx = queue_idx;
+        }
+    }
+    return next_idx;
+}
+#endif
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static uint32_t _UHFM_uplink_queue_get_next_time(uint32_t uptime_seconds) {
+    // Local variables.
+    uint32_t next_time_seconds = 0;
+    uint8_t next_time_valid = 0;
+    uint8_t queue_idx = 0;
+    // Entries loop.
+    for (queue_idx = 0; queue_idx < UHFM_UPLINK_QUEUE_DEPTH; queue_idx++) {
+        if ((uhfm_ctx.uplink_queue[queue_idx].marker) != UHFM_UPLINK_QUEUE_NVM_MARKER) continue;
+        // Select the earliest retry time.
+        if ((next_time_valid == 0) || (uhfm_ctx.uplink_queue_retry_time_seconds[queue_idx] < next_time_seconds)) {
+            next_time_seconds = uhfm_ctx.uplink_queue_retry_time_seconds[queue_idx];
+            next_time_valid = 1;
+        }
+    }
+    // Entries which are ready but blocked by the radio are retried after the delay.
+    if (next_time_seconds <= uptime_seconds) {
+        next_time_seconds = (uptime_seconds + UHFM_UPLINK_QUEUE_RETRY_DELAY_SECONDS);
+    }
+    return next_time_seconds;
+}
+#endif
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static NODE_status_t _UHFM_uplink_queue_release(uint8_t queue_idx, uint8_t message_sent) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    UHFM_uplink_t* uplink_ptr = &(uhfm_ctx.uplink_queue[queue_idx]);
+    // Check message status.
+    if (message_sent == 0) {
+        // Postpone next attempt of this message only.
+        uhfm_ctx.uplink_queue_retry_time_seconds[queue_idx] = (RTC_get_uptime_seconds() + UHFM_UPLINK_QUEUE_RETRY_DELAY_SECONDS);
+        uplink_ptr->retry_count++;
+        // Keep message until the maximum number of retries.
+        if ((uplink_ptr->retry_count) <= UHFM_UPLINK_QUEUE_RETRY_MAX) {
+            status = _UHFM_uplink_queue_store(queue_idx, &(uplink_ptr->retry_count), 1);
+            goto errors;
+        }
+        uhfm_ctx.uplink_queue_drop_count++;
+    }
+    // Remove entry.
+    uplink_ptr->marker = 0;
+    status = _UHFM_uplink_queue_store(queue_idx, &(uplink_ptr->marker), 1);
+    if (status != NODE_SUCCESS) goto errors;
+errors:
+    return status;
+}
+#endif
+
+/*******************************************************************/
+static NODE_status_t _UHFM_send_uplink(UHFM_uplink_t* uplink) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
     SIGFOX_EP_API_status_t sigfox_ep_api_status = SIGFOX_EP_API_SUCCESS;
@@ -286,14 +644,11 @@ static NODE_status_t _UHFM_strg_callback(void) {
 #endif
     SIGFOX_EP_API_message_status_t message_status;
     uint32_t* reg_status_1_ptr = &(NODE_RAM_REGISTER[UHFM_REGISTER_ADDRESS_STATUS_1]);
-    uint32_t reg_control_1 = NODE_RAM_REGISTER[UHFM_REGISTER_ADDRESS_CONTROL_1];
     uint32_t reg_config_0 = NODE_RAM_REGISTER[UHFM_REGISTER_ADDRESS_CONFIGURATION_0];
 #if (!(defined SIGFOX_EP_T_IFU_MS) || !(defined SIGFOX_EP_T_CONF_MS))
     uint32_t reg_config_1 = NODE_RAM_REGISTER[UHFM_REGISTER_ADDRESS_CONFIGURATION_1];
 #endif
-    sfx_bool bidirectional_flag = 0;
-    uint8_t ul_payload[SIGFOX_UL_PAYLOAD_MAX_SIZE_BYTES];
-    uint8_t ul_payload_size = 0;
+    sfx_bool bidirectional_flag = (((uplink->flags) & UHFM_UPLINK_FLAG_SBF) != 0) ? SIGFOX_TRUE : SIGFOX_FALSE;
     uint8_t dl_payload[SIGFOX_DL_PAYLOAD_SIZE_BYTES];
     int16_t dl_rssi_dbm = 0;
     uint8_t nvm_data[SIGFOX_NVM_DATA_SIZE_BYTES];
@@ -312,14 +667,8 @@ static NODE_status_t _UHFM_strg_callback(void) {
     SIGFOX_EP_API_check_status(NODE_ERROR_SIGFOX_EP_API);
 #ifdef SIGFOX_EP_CONTROL_KEEP_ALIVE_MESSAGE
     // Check control message flag.
-    if (SWREG_read_field(reg_control_1, UHFM_REGISTER_CONTROL_1_MASK_SCMF) == 0) {
-#endif
-        // Get payload size.
-        ul_payload_size = (sfx_u8) SWREG_read_field(reg_control_1, UHFM_REGISTER_CONTROL_1_MASK_SIGFOX_UL_PAYLOAD_SIZE);
-        // Read UL payload.
-        SWREG_read_byte_array(ul_payload, ul_payload_size, &(NODE_RAM_REGISTER[UHFM_REGISTER_ADDRESS_SIGFOX_UL_PAYLOAD_0]));
-        // Update bidirectional flag.
-        bidirectional_flag = (sfx_bool) SWREG_read_field(reg_control_1, UHFM_REGISTER_CONTROL_1_MASK_SBF);
+    if (((uplink->flags) & UHFM_UPLINK_FLAG_SCMF) == 0) {
+#endif
         // Read current message counter.
         if (bidirectional_flag == SIGFOX_TRUE) {
             // Read memory.
@@ -341,10 +690,10 @@ static NODE_status_t _UHFM_strg_callback(void) {
 #ifdef SIGFOX_EP_PUBLIC_KEY_CAPABLE
         application_message.common_parameters.ep_key_type = SIGFOX_EP_KEY_PRIVATE;
 #endif
-        application_message.type = (SIGFOX_application_message_type_t) SWREG_read_field(reg_control_1, UHFM_REGISTER_CONTROL_1_MASK_SIGFOX_MSGT);
+        application_message.type = (SIGFOX_application_message_type_t) (uplink->message_type);
         application_message.bidirectional_flag = bidirectional_flag;
-        application_message.ul_payload = (sfx_u8*) ul_payload;
-        application_message.ul_payload_size_bytes = ul_payload_size;
+        application_message.ul_payload = (sfx_u8*) (uplink->ul_payload);
+        application_message.ul_payload_size_bytes = (uplink->ul_payload_size);
 #ifndef SIGFOX_EP_T_CONF_MS
         application_message.t_conf_ms = (sfx_u16) SWREG_read_field(reg_config_1, UHFM_REGISTER_CONFIGURATION_1_MASK_SIGFOX_T_CONF);
 #endif
@@ -365,8 +714,8 @@ static NODE_status_t _UHFM_strg_callback(void) {
 #ifdef SIGFOX_EP_CONTROL_KEEP_ALIVE_MESSAGE
     }
     else {
-        control_message.common_parameters.number_of_frames = (sfx_u8) SWREG_read_field(reg_config_1, UHFM_REGISTER_CONFIGURATION_0_MASK_SNFR);
-        control_message.common_parameters.ul_bit_rate = (SIGFOX_ul_bit_rate_t) SWREG_read_field(reg_config_1, UHFM_REGISTER_CONFIGURATION_0_MASK_SBR);
+        control_message.common_parameters.number_of_frames = (sfx_u8) SWREG_read_field(reg_config_0, UHFM_REGISTER_CONFIGURATION_0_MASK_SNFR);
+        control_message.common_parameters.ul_bit_rate = (SIGFOX_ul_bit_rate_t) SWREG_read_field(reg_config_0, UHFM_REGISTER_CONFIGURATION_0_MASK_SBR);
 #ifdef SIGFOX_EP_PUBLIC_KEY_CAPABLE
         control_message.common_parameters.ep_key_type = SIGFOX_EP_KEY_PRIVATE;
 #endif
@@ -390,6 +739,73 @@ errors:
     return status;
 }
 
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+static NODE_status_t _UHFM_uplink_queue_send(uint8_t uplink_queue_idx) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    NODE_status_t node_status = NODE_SUCCESS;
+    uint8_t queue_idx = uplink_queue_idx;
+    uint8_t message_sent = 0;
+    // Check radio state.
+    if (_UHFM_is_radio_free() != NODE_SUCCESS) goto errors;
+    // Get next message in sending order if no entry is given.
+    if (queue_idx == UHFM_UPLINK_QUEUE_INDEX_NONE) {
+        queue_idx = _UHFM_uplink_queue_get_next_index(RTC_get_uptime_seconds());
+    }
+    if (queue_idx == UHFM_UPLINK_QUEUE_INDEX_NONE) goto errors;
+    // Send message.
+    status = _UHFM_send_uplink(&(uhfm_ctx.uplink_queue[queue_idx]));
+    message_sent = ((status == NODE_SUCCESS) && (SWREG_read_field(NODE_RAM_REGISTER[UHFM_REGISTER_ADDRESS_STATUS_1], UHFM_REGISTER_STATUS_1_MASK_SIGFOX_MESSAGE_STATUS) != 0)) ? 1 : 0;
+    // Status registers now belong to this message.
+    uhfm_ctx.uplink_queue_last_sent_id = (int32_t) (uhfm_ctx.uplink_queue[queue_idx].sequence);
+    // Remove message from the queue or schedule a retry.
+    node_status = _UHFM_uplink_queue_release(queue_idx, message_sent);
+    // Keep first error.
+    if (status == NODE_SUCCESS) {
+        status = node_status;
+    }
+errors:
+    // Register next queued message.
+    if (_UHFM_uplink_queue_get_depth() != 0) {
+        if ((_UHFM_uplink_queue_get_next_index(RTC_get_uptime_seconds()) != UHFM_UPLINK_QUEUE_INDEX_NONE) && (_UHFM_is_radio_free() == NODE_SUCCESS)) {
+            SCHEDULER_post_event(SCHEDULER_TASK_NODE);
+        }
+        else {
+            // Wait for the earliest retry delay or for the radio to be released.
+            SCHEDULER_set_deadline(SCHEDULER_TASK_NODE, _UHFM_uplink_queue_get_next_time(RTC_get_uptime_seconds()));
+        }
+    }
+    return status;
+}
+#endif
+
+/*******************************************************************/
+static NODE_status_t _UHFM_strg_callback(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    UHFM_uplink_t uplink;
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+    uint8_t queue_idx = UHFM_UPLINK_QUEUE_INDEX_NONE;
+#endif
+    // Read message.
+    _UHFM_read_uplink(&uplink);
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+    // Add message to the queue.
+    status = _UHFM_uplink_queue_push(&uplink, &queue_idx);
+    if (status != NODE_SUCCESS) goto errors;
+    // Send the requested message now if possible, so that the status registers describe it.
+    status = _UHFM_uplink_queue_send(queue_idx);
+    if (status != NODE_SUCCESS) goto errors;
+#else
+    // Send message.
+    status = _UHFM_send_uplink(&uplink);
+    if (status != NODE_SUCCESS) goto errors;
+#endif
+errors:
+    return status;
+}
+
 /*******************************************************************/
 static void _UHFM_ttrg_downlink_completion_callback(sfx_u8 *dl_payload, sfx_u8 dl_payload_size, sfx_s16 rssi_dbm) {
     AT_reply_add_string("+RX=");
@@ -453,7 +869,20 @@ NODE_status_t UHFM_init(void) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
     // Init context.
-    uhfm_cwen_flag = 0;
+    uhfm_ctx.cwen_flag = 0;
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+    uhfm_ctx.uplink_queue_last_queued_id = UHFM_UPLINK_QUEUE_ID_NONE;
+    uhfm_ctx.uplink_queue_last_sent_id = UHFM_UPLINK_QUEUE_ID_NONE;
+    uhfm_ctx.uplink_queue_drop_count = 0;
+    uhfm_ctx.uplink_queue_duplicate_count = 0;
+    // Recover messages which were pending before reset.
+    status = _UHFM_uplink_queue_load();
+    if (status != NODE_SUCCESS) goto errors;
+    if (_UHFM_uplink_queue_get_depth() != 0) {
+        SCHEDULER_post_event(SCHEDULER_TASK_NODE);
+    }
+errors:
+#endif
     return status;
 }
 
@@ -602,16 +1031,16 @@ NODE_status_t UHFM_process_register(uint8_t reg_addr, uint32_t reg_mask) {
             // Read bit.
             cwen = SWREG_read_field((*reg_ptr), UHFM_REGISTER_CONTROL_1_MASK_CWEN);
             // Compare to current state.
-            if (cwen != uhfm_cwen_flag) {
+            if (cwen != uhfm_ctx.cwen_flag) {
                 // Start or stop CW.
                 status = _UHFM_cwen_callback(cwen);
                 if (status != NODE_SUCCESS) {
                     // Update state.
-                    SWREG_write_field(reg_ptr, &unused_mask, uhfm_cwen_flag, UHFM_REGISTER_CONTROL_1_MASK_CWEN);
+                    SWREG_write_field(reg_ptr, &unused_mask, uhfm_ctx.cwen_flag, UHFM_REGISTER_CONTROL_1_MASK_CWEN);
                     goto errors;
                 }
                 // Update local flag.
-                uhfm_cwen_flag = cwen;
+                uhfm_ctx.cwen_flag = cwen;
             }
         }
         break;
@@ -623,6 +1052,35 @@ errors:
     return status;
 }
 
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+NODE_status_t UHFM_process(void) {
+    // Send queued messages.
+    return _UHFM_uplink_queue_send(UHFM_UPLINK_QUEUE_INDEX_NONE);
+}
+#endif
+
+#ifdef UHFM_UPLINK_QUEUE_DEPTH
+/*******************************************************************/
+NODE_status_t UHFM_get_uplink_queue_status(UHFM_uplink_queue_status_t* queue_status) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    // Check parameter.
+    if (queue_status == NULL) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Read status.
+    queue_status->depth = _UHFM_uplink_queue_get_depth();
+    queue_status->drop_count = uhfm_ctx.uplink_queue_drop_count;
+    queue_status->duplicate_count = uhfm_ctx.uplink_queue_duplicate_count;
+    queue_status->last_queued_id = uhfm_ctx.uplink_queue_last_queued_id;
+    queue_status->last_sent_id = uhfm_ctx.uplink_queue_last_sent_id;
+errors:
+    return status;
+}
+#endif
+
 /*******************************************************************/
 NODE_status_t UHFM_mtrg_callback(void) {
     // Local variables.
@@ -94,6 +94,17 @@ typedef enum {
     POWER_DOMAIN_LAST
 } POWER_domain_t;
 
+/*!******************************************************************
+ * \enum POWER_state_t
+ * \brief Power domain states list.
+ *******************************************************************/
+typedef enum {
+    POWER_STATE_OFF = 0,
+    POWER_STATE_RAMPING,
+    POWER_STATE_READY,
+    POWER_STATE_LAST
+} POWER_state_t;
+
 /*** POWER functions ***/
 
 /*!******************************************************************
@@ -105,6 +116,25 @@ typedef enum {
  *******************************************************************/
 void POWER_init(void);
 
+/*!******************************************************************
+ * \fn void POWER_request(POWER_requester_id_t requester_id, POWER_domain_t domain)
+ * \brief Turn power domain on without waiting for the power on delay.
+ * \param[in]   requester_id: Identifier of the calling driver.
+ * \param[in]   domain: Power domain to enable.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void POWER_request(POWER_requester_id_t requester_id, POWER_domain_t domain);
+
+/*!******************************************************************
+ * \fn void POWER_wait(LPTIM_delay_mode_t delay_mode)
+ * \brief Blocking wait until all the requested power domains are ready (single delay of the longest remaining power on time).
+ * \param[in]   delay_mode: Power on delay waiting mode.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void POWER_wait(LPTIM_delay_mode_t delay_mode);
+
 /*!******************************************************************
  * \fn void POWER_enable(POWER_requester_id_t requester_id, POWER_domain_t domain, LPTIM_delay_mode_t delay_mode)
  * \brief Turn power domain on.
@@ -127,12 +157,12 @@ void POWER_enable(POWER_requester_id_t requester_id, POWER_domain_t domain, LPTI
 void POWER_disable(POWER_requester_id_t requester_id, POWER_domain_t domain);
 
 /*!******************************************************************
- * \fn uint8_t POWER_get_state(POWER_domain_t domain)
+ * \fn POWER_state_t POWER_get_state(POWER_domain_t domain)
  * \brief Return the current state of a power domain.
  * \param[in]   domain: Power domain to check.
  * \param[out]  none
  * \retval      Power domain state.
  *******************************************************************/
-uint8_t POWER_get_state(POWER_domain_t domain);
+POWER_state_t POWER_get_state(POWER_domain_t domain);
 
 #endif /* __POWER_H__ */
@@ -20,9 +20,18 @@
 #include "sx126x.h"
 #include "types.h"
 
+/*** POWER local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t requesters[POWER_DOMAIN_LAST];
+    POWER_state_t state[POWER_DOMAIN_LAST];
+    uint32_t ramp_remaining_ms[POWER_DOMAIN_LAST];
+} POWER_context_t;
+
 /*** POWER local global variables ***/
 
-static uint32_t power_domain_state[POWER_DOMAIN_LAST] = { [0 ... (POWER_DOMAIN_LAST - 1)] = 0 };
+static POWER_context_t power_ctx;
 
 /*** POWER local functions ***/
 
@@ -34,6 +43,35 @@ static uint32_t power_domain_state[POWER_DOMAIN_LAST] = { [0 ... (POWER_DOMAIN_L
     } \
 }
 
+/*******************************************************************/
+static void _POWER_wait(uint32_t domain_mask, LPTIM_delay_mode_t delay_mode) {
+    // Local variables.
+    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    uint32_t delay_ms = 0;
+    uint8_t idx = 0;
+    // Compute the longest remaining ramp time of the selected domains.
+    for (idx = 0; idx < POWER_DOMAIN_LAST; idx++) {
+        if (((domain_mask & (0b1 << idx)) != 0) && (power_ctx.state[idx] == POWER_STATE_RAMPING) && (power_ctx.ramp_remaining_ms[idx] > delay_ms)) {
+            delay_ms = power_ctx.ramp_remaining_ms[idx];
+        }
+    }
+    // Power on delay.
+    if (delay_ms != 0) {
+        lptim_status = LPTIM_delay_milliseconds(delay_ms, delay_mode);
+        _POWER_stack_driver_error(lptim_status, LPTIM_SUCCESS, ERROR_BASE_LPTIM, POWER_ERROR_DRIVER_LPTIM);
+    }
+    // Update all ramping domains since they were powered during the delay.
+    for (idx = 0; idx < POWER_DOMAIN_LAST; idx++) {
+        // Check state.
+        if (power_ctx.state[idx] != POWER_STATE_RAMPING) continue;
+        // Update remaining time.
+        power_ctx.ramp_remaining_ms[idx] = (power_ctx.ramp_remaining_ms[idx] > delay_ms) ? (power_ctx.ramp_remaining_ms[idx] - delay_ms) : 0;
+        if (power_ctx.ramp_remaining_ms[idx] == 0) {
+            power_ctx.state[idx] = POWER_STATE_READY;
+        }
+    }
+}
+
 /*** POWER functions ***/
 
 /*******************************************************************/
@@ -42,7 +80,9 @@ void POWER_init(void) {
     uint8_t idx = 0;
     // Init context.
     for (idx = 0; idx < POWER_DOMAIN_LAST; idx++) {
-        power_domain_state[idx] = 0;
+        power_ctx.requesters[idx] = 0;
+        power_ctx.state[idx] = POWER_STATE_OFF;
+        power_ctx.ramp_remaining_ms[idx] = 0;
     }
     // Init power control pins.
 #if (((defined LVRM) && (defined HW2_0)) || (defined BCM) || (defined BPSM))
@@ -71,10 +111,9 @@ void POWER_init(void) {
 }
 
 /*******************************************************************/
-void POWER_enable(POWER_requester_id_t requester_id, POWER_domain_t domain, LPTIM_delay_mode_t delay_mode) {
+void POWER_request(POWER_requester_id_t requester_id, POWER_domain_t domain) {
     // Local variables.
     ANALOG_status_t analog_status = ANALOG_SUCCESS;
-    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
 #ifdef SM
     DIGITAL_status_t digital_status = DIGITAL_SUCCESS;
     SHT3X_status_t sht3x_status = SHT3X_SUCCESS;
@@ -102,9 +141,9 @@ void POWER_enable(POWER_requester_id_t requester_id, POWER_domain_t domain, LPTI
         ERROR_stack_add(ERROR_BASE_POWER + POWER_ERROR_DOMAIN);
         goto errors;
     }
-    action_required = ((power_domain_state[domain] == 0) ? 1 : 0);
+    action_required = ((power_ctx.requesters[domain] == 0) ? 1 : 0);
     // Update state.
-    power_domain_state[domain] |= (0b1 << requester_id);
+    power_ctx.requesters[domain] |= (0b1 << requester_id);
     // Directly exit if this is not the first request.
     if (action_required == 0) goto errors;
     // Check domain.
@@ -191,15 +230,29 @@ void POWER_enable(POWER_requester_id_t requester_id, POWER_domain_t domain, LPTI
         ERROR_stack_add(ERROR_BASE_POWER + POWER_ERROR_DOMAIN);
         goto errors;
     }
-    // Power on delay.
-    if (delay_ms != 0) {
-        lptim_status = LPTIM_delay_milliseconds(delay_ms, delay_mode);
-        _POWER_stack_driver_error(lptim_status, LPTIM_SUCCESS, ERROR_BASE_LPTIM, POWER_ERROR_DRIVER_LPTIM);
-    }
+    // Start power on delay.
+    power_ctx.ramp_remaining_ms[domain] = delay_ms;
+    power_ctx.state[domain] = (delay_ms != 0) ? POWER_STATE_RAMPING : POWER_STATE_READY;
 errors:
     return;
 }
 
+/*******************************************************************/
+void POWER_wait(LPTIM_delay_mode_t delay_mode) {
+    // Wait for all ramping domains.
+    _POWER_wait(0xFFFFFFFF, delay_mode);
+}
+
+/*******************************************************************/
+void POWER_enable(POWER_requester_id_t requester_id, POWER_domain_t domain, LPTIM_delay_mode_t delay_mode) {
+    // Turn domain on.
+    POWER_request(requester_id, domain);
+    // Wait for this domain only.
+    if (domain < POWER_DOMAIN_LAST) {
+        _POWER_wait((0b1 << domain), delay_mode);
+    }
+}
+
 /*******************************************************************/
 void POWER_disable(POWER_requester_id_t requester_id, POWER_domain_t domain) {
     // Local variables.
@@ -229,11 +282,14 @@ void POWER_disable(POWER_requester_id_t requester_id, POWER_domain_t domain) {
         ERROR_stack_add(ERROR_BASE_POWER + POWER_ERROR_DOMAIN);
         goto errors;
     }
-    if (power_domain_state[domain] == 0) goto errors;
+    if (power_ctx.requesters[domain] == 0) goto errors;
     // Update state.
-    power_domain_state[domain] &= ~(0b1 << requester_id);
+    power_ctx.requesters[domain] &= ~(0b1 << requester_id);
     // Directly exit if this is not the last request.
-    if (power_domain_state[domain] != 0) goto errors;
+    if (power_ctx.requesters[domain] != 0) goto errors;
+    // Update state.
+    power_ctx.state[domain] = POWER_STATE_OFF;
+    power_ctx.ramp_remaining_ms[domain] = 0;
     // Check domain.
     switch (domain) {
     case POWER_DOMAIN_ANALOG:
@@ -316,15 +372,15 @@ errors:
 }
 
 /*******************************************************************/
-uint8_t POWER_get_state(POWER_domain_t domain) {
+POWER_state_t POWER_get_state(POWER_domain_t domain) {
     // Local variables.
-    uint8_t state = 0;
+    POWER_state_t state = POWER_STATE_OFF;
     // Check parameters.
     if (domain >= POWER_DOMAIN_LAST) {
         ERROR_stack_add(ERROR_BASE_POWER + POWER_ERROR_DOMAIN);
         goto errors;
     }
-    state = (power_domain_state[domain] == 0) ? 0 : 1;
+    state = power_ctx.state[domain];
 errors:
     return state;
 }
@@ -0,0 +1,97 @@
+/*
+ * scheduler.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+
+#include "types.h"
+
+/*** SCHEDULER macros ***/
+
+#define SCHEDULER_DEADLINE_NONE     0xFFFFFFFF
+
+/*** SCHEDULER structures ***/
+
+/*!******************************************************************
+ * \enum SCHEDULER_task_t
+ * \brief Scheduled tasks list.
+ *******************************************************************/
+typedef enum {
+    SCHEDULER_TASK_CLI = 0,
+    SCHEDULER_TASK_NODE,
+    SCHEDULER_TASK_LAST
+} SCHEDULER_task_t;
+
+/*!******************************************************************
+ * \struct SCHEDULER_statistics_t
+ * \brief Scheduler wakeup statistics.
+ *******************************************************************/
+typedef struct {
+    uint32_t number_of_wakeups;
+    uint32_t number_of_idle_wakeups;
+    uint32_t number_of_event_runs[SCHEDULER_TASK_LAST];
+    uint32_t number_of_deadline_runs[SCHEDULER_TASK_LAST];
+} SCHEDULER_statistics_t;
+
+/*** SCHEDULER functions ***/
+
+/*!******************************************************************
+ * \fn void SCHEDULER_init(void)
+ * \brief Init scheduler.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SCHEDULER_init(void);
+
+/*!******************************************************************
+ * \fn void SCHEDULER_post_event(SCHEDULER_task_t task)
+ * \brief Request a task to run as soon as possible (can be called from interrupt context).
+ * \param[in]   task: Task to run.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SCHEDULER_post_event(SCHEDULER_task_t task);
+
+/*!******************************************************************
+ * \fn void SCHEDULER_set_deadline(SCHEDULER_task_t task, uint32_t time_seconds)
+ * \brief Request a task to run at a given uptime (the earliest deadline is kept).
+ * \param[in]   task: Task to run.
+ * \param[in]   time_seconds: Uptime at which the task has to run.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SCHEDULER_set_deadline(SCHEDULER_task_t task, uint32_t time_seconds);
+
+/*!******************************************************************
+ * \fn uint8_t SCHEDULER_is_idle(void)
+ * \brief Check if all tasks are waiting for an event or a deadline (to be called with interrupts masked before entering low power mode).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      1 if no task has to run, 0 otherwise.
+ *******************************************************************/
+uint8_t SCHEDULER_is_idle(void);
+
+/*!******************************************************************
+ * \fn uint32_t SCHEDULER_get_ready_tasks(void)
+ * \brief Get and acknowledge the tasks which have to run.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Bit mask of the tasks to run.
+ *******************************************************************/
+uint32_t SCHEDULER_get_ready_tasks(void);
+
+/*!******************************************************************
+ * \fn void SCHEDULER_get_statistics(SCHEDULER_statistics_t* statistics)
+ * \brief Get scheduler wakeup statistics.
+ * \param[in]   none
+ * \param[out]  statistics: Pointer to the scheduler statistics.
+ * \retval      none
+ *******************************************************************/
+void SCHEDULER_get_statistics(SCHEDULER_statistics_t* statistics);
+
+#endif /* __SCHEDULER_H__ */
@@ -0,0 +1,127 @@
+/*
+ * scheduler.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "scheduler.h"
+
+#include "rtc.h"
+#include "types.h"
+
+/*** SCHEDULER local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    volatile uint8_t event_flag[SCHEDULER_TASK_LAST];
+    uint32_t deadline_seconds[SCHEDULER_TASK_LAST];
+    uint8_t sleep_flag;
+    SCHEDULER_statistics_t statistics;
+} SCHEDULER_context_t;
+
+/*** SCHEDULER local global variables ***/
+
+static SCHEDULER_context_t scheduler_ctx;
+
+/*** SCHEDULER local functions ***/
+
+/*******************************************************************/
+static uint8_t _SCHEDULER_is_deadline_reached(SCHEDULER_task_t task, uint32_t uptime_seconds) {
+    return (((scheduler_ctx.deadline_seconds[task] != SCHEDULER_DEADLINE_NONE) && (uptime_seconds >= scheduler_ctx.deadline_seconds[task])) ? 1 : 0);
+}
+
+/*** SCHEDULER functions ***/
+
+/*******************************************************************/
+void SCHEDULER_init(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Run all tasks once at startup so that they register their own deadlines.
+    for (idx = 0; idx < SCHEDULER_TASK_LAST; idx++) {
+        scheduler_ctx.event_flag[idx] = 1;
+        scheduler_ctx.deadline_seconds[idx] = SCHEDULER_DEADLINE_NONE;
+        scheduler_ctx.statistics.number_of_event_runs[idx] = 0;
+        scheduler_ctx.statistics.number_of_deadline_runs[idx] = 0;
+    }
+    scheduler_ctx.sleep_flag = 0;
+    scheduler_ctx.statistics.number_of_wakeups = 0;
+    scheduler_ctx.statistics.number_of_idle_wakeups = 0;
+}
+
+/*******************************************************************/
+void SCHEDULER_post_event(SCHEDULER_task_t task) {
+    // Check parameter.
+    if (task >= SCHEDULER_TASK_LAST) return;
+    // Set flag.
+    scheduler_ctx.event_flag[task] = 1;
+}
+
+/*******************************************************************/
+void SCHEDULER_set_deadline(SCHEDULER_task_t task, uint32_t time_seconds) {
+    // Check parameter.
+    if (task >= SCHEDULER_TASK_LAST) return;
+    // Keep earliest deadline.
+    if (time_seconds < scheduler_ctx.deadline_seconds[task]) {
+        scheduler_ctx.deadline_seconds[task] = time_seconds;
+    }
+}
+
+/*******************************************************************/
+uint8_t SCHEDULER_is_idle(void) {
+    // Local variables.
+    uint32_t uptime_seconds = RTC_get_uptime_seconds();
+    uint8_t idx = 0;
+    // Tasks loop.
+    for (idx = 0; idx < SCHEDULER_TASK_LAST; idx++) {
+        if ((scheduler_ctx.event_flag[idx] != 0) || (_SCHEDULER_is_deadline_reached(idx, uptime_seconds) != 0)) {
+            return 0;
+        }
+    }
+    // The caller enters low power mode when all tasks are idle.
+    scheduler_ctx.sleep_flag = 1;
+    return 1;
+}
+
+/*******************************************************************/
+uint32_t SCHEDULER_get_ready_tasks(void) {
+    // Local variables.
+    uint32_t ready_tasks = 0;
+    uint32_t uptime_seconds = RTC_get_uptime_seconds();
+    uint8_t idx = 0;
+    // Tasks loop.
+    for (idx = 0; idx < SCHEDULER_TASK_LAST; idx++) {
+        // Check event.
+        if (scheduler_ctx.event_flag[idx] != 0) {
+            // Clear flag.
+            scheduler_ctx.event_flag[idx] = 0;
+            scheduler_ctx.statistics.number_of_event_runs[idx]++;
+        }
+        else if (_SCHEDULER_is_deadline_reached(idx, uptime_seconds) != 0) {
+            scheduler_ctx.statistics.number_of_deadline_runs[idx]++;
+        }
+        else {
+            continue;
+        }
+        // Deadline is registered again by the task itself if needed.
+        scheduler_ctx.deadline_seconds[idx] = SCHEDULER_DEADLINE_NONE;
+        ready_tasks |= (0b1 << idx);
+    }
+    // Update statistics only when the loop has been woken up from low power mode.
+    if (scheduler_ctx.sleep_flag != 0) {
+        scheduler_ctx.sleep_flag = 0;
+        scheduler_ctx.statistics.number_of_wakeups++;
+        if (ready_tasks == 0) {
+            scheduler_ctx.statistics.number_of_idle_wakeups++;
+        }
+    }
+    return ready_tasks;
+}
+
+/*******************************************************************/
+void SCHEDULER_get_statistics(SCHEDULER_statistics_t* statistics) {
+    // Check parameter.
+    if (statistics == NULL) return;
+    // Copy statistics.
+    (*statistics) = scheduler_ctx.statistics;
+}
@@ -72,6 +72,14 @@ typedef enum {
     MCU_API_ERROR_DRIVER_TIM
 } MCU_API_custom_status_t;
 
+#ifdef SIGFOX_EP_AES_HW
+typedef struct {
+    // Note: the key is only written in NVM during factory programming, so the cache is reloaded after each reset.
+    uint8_t ep_key[SIGFOX_EP_KEY_SIZE_BYTES];
+    uint8_t ep_key_valid;
+} MCU_API_context_t;
+#endif
+
 /*** MCU API local global variables ***/
 
 #if (defined SIGFOX_EP_TIMER_REQUIRED) && (defined SIGFOX_EP_LATENCY_COMPENSATION) && (defined SIGFOX_EP_BIDIRECTIONAL)
@@ -80,6 +88,34 @@ static sfx_u32 MCU_API_LATENCY_MS[MCU_API_LATENCY_LAST] = {
 };
 #endif
 
+#ifdef SIGFOX_EP_AES_HW
+static MCU_API_context_t mcu_api_ctx = {
+    .ep_key_valid = 0
+};
+#endif
+
+/*** MCU API local functions ***/
+
+#ifdef SIGFOX_EP_AES_HW
+/*******************************************************************/
+static MCU_API_status_t _MCU_API_load_ep_key(void) {
+    // Local variables.
+    MCU_API_status_t status = MCU_API_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t idx = 0;
+    // Check cache.
+    if (mcu_api_ctx.ep_key_valid != 0) goto errors;
+    // Retrieve private key from NVM.
+    for (idx = 0; idx < SIGFOX_EP_KEY_SIZE_BYTES; idx++) {
+        nvm_status = NVM_read_byte((NVM_ADDRESS_SIGFOX_EP_KEY + idx), &(mcu_api_ctx.ep_key[idx]));
+        NVM_stack_exit_error(ERROR_BASE_NVM, (MCU_API_status_t) MCU_API_ERROR_DRIVER_NVM);
+    }
+    mcu_api_ctx.ep_key_valid = 1;
+errors:
+    SIGFOX_RETURN();
+}
+#endif
+
 /*** MCU API functions ***/
 
 #if (defined SIGFOX_EP_ASYNCHRONOUS) || (defined SIGFOX_EP_LOW_LEVEL_OPEN_CLOSE)
@@ -198,41 +234,33 @@ errors:
 MCU_API_status_t MCU_API_aes_128_cbc_encrypt(MCU_API_encryption_data_t* aes_data) {
     // Local variables.
     MCU_API_status_t status = MCU_API_SUCCESS;
-    NVM_status_t nvm_status = NVM_SUCCESS;
     AES_status_t aes_status = AES_SUCCESS;
-    uint8_t idx = 0;
-    uint8_t local_key[SIGFOX_EP_KEY_SIZE_BYTES];
+    uint8_t* key_ptr = (uint8_t*) mcu_api_ctx.ep_key;
     // Get right key.
 #ifdef SIGFOX_EP_PUBLIC_KEY_CAPABLE
     switch (aes_data -> key) {
     case SIGFOX_EP_KEY_PRIVATE:
-        // Retrieve private key from NVM.
-        for (idx = 0; idx < SIGFOX_EP_KEY_SIZE_BYTES; idx++) {
-            nvm_status = NVM_read_byte((NVM_ADDRESS_SIGFOX_EP_KEY + idx), &(local_key[idx]));
-            NVM_stack_exit_error(ERROR_BASE_NVM, (MCU_API_status_t) MCU_API_ERROR_DRIVER_NVM);
-        }
+        // Load private key cache.
+        status = _MCU_API_load_ep_key();
+        SIGFOX_CHECK_STATUS(MCU_API_SUCCESS);
         break;
     case SIGFOX_EP_KEY_PUBLIC:
         // Use public key.
-        for (idx = 0; idx < SIGFOX_EP_KEY_SIZE_BYTES; idx++) {
-            local_key[idx] = SIGFOX_EP_PUBLIC_KEY[idx];
-        }
+        key_ptr = (uint8_t*) SIGFOX_EP_PUBLIC_KEY;
         break;
     default:
         SIGFOX_EXIT_ERROR((MCU_API_status_t) MCU_API_ERROR_EP_KEY);
         break;
     }
 #else
-    // Retrieve private key from NVM.
-    for (idx = 0; idx < SIGFOX_EP_KEY_SIZE_BYTES; idx++) {
-        nvm_status = NVM_read_byte((NVM_ADDRESS_SIGFOX_EP_KEY + idx), &(local_key[idx]));
-        NVM_stack_exit_error(ERROR_BASE_NVM, (MCU_API_status_t) MCU_API_ERROR_DRIVER_NVM);
-    }
+    // Load private key cache.
+    status = _MCU_API_load_ep_key();
+    SIGFOX_CHECK_STATUS(MCU_API_SUCCESS);
 #endif
     // Init peripheral.
     AES_init();
     // Perform AES.
-    aes_status = AES_encrypt((aes_data->data), (aes_data->data), local_key);
+    aes_status = AES_encrypt((aes_data->data), (aes_data->data), key_ptr);
     AES_stack_exit_error(ERROR_BASE_AES, (MCU_API_status_t) MCU_API_ERROR_DRIVER_AES);
 errors:
     // Release peripheral.
@@ -241,6 +269,9 @@ errors:
 }
 #endif
 
+// Note: hardware CRC is not used (SIGFOX_EP_CRC_HW is disabled in sigfox_ep_flags.h) and the functions below are kept as stubs.
+// The STM32L0 CRC unit could compute the 16 and 8 bits CRC, but this would require a new CRC driver in the peripheral drivers library,
+// and the software CRC of the library only processes a few bytes per frame.
 #ifdef SIGFOX_EP_CRC_HW
 /*******************************************************************/
 MCU_API_status_t MCU_API_compute_crc16(sfx_u8 *data, sfx_u8 data_size, sfx_u16 polynom, sfx_u16 *crc) {
@@ -68,8 +68,6 @@
 #define RF_API_FDEV_NEGATIVE                    0x7F
 #define RF_API_FDEV_POSITIVE                    0x81
 
-#define RF_API_FIFO_BUFFER_FDEV_IDX             (RF_API_SYMBOL_PROFILE_SIZE_BYTES >> 1)
-
 #define RF_API_FIFO_TX_ALMOST_EMPTY_THRESHOLD   (RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES >> 1)
 
 #define RF_API_SMPS_FREQUENCY_HZ_TX             5500000
@@ -83,8 +81,55 @@
 #define RF_API_DOWNLINK_RSSI_THRESHOLD_DBM      -139
 #endif
 
-static const sfx_u8 RF_API_RAMP_AMPLITUDE_PROFILE[RF_API_SYMBOL_PROFILE_SIZE_BYTES] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 3, 3, 5, 7, 10, 14, 19, 25, 31, 39, 60, 220 };
-static const sfx_u8 RF_API_BIT0_AMPLITUDE_PROFILE[RF_API_SYMBOL_PROFILE_SIZE_BYTES] = { 1, 1, 1, 1, 1, 2, 2, 2, 3, 3, 5, 7, 10, 14, 19, 25, 31, 39, 60, 220, 220, 60, 39, 31, 25, 19, 14, 10, 7, 5, 3, 3, 2, 2, 2, 1, 1, 1, 1, 1 };
+// FIFO frames are made of (deviation, PA output power) pairs for each of the 40 samples of a symbol.
+// Ramp-up: no deviation, increasing PA output power.
+static const sfx_u8 RF_API_FIFO_FRAME_RAMP_UP[RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES] = {
+    0, 220, 0, 60, 0, 39, 0, 31, 0, 25, 0, 19, 0, 14, 0, 10,
+    0, 7, 0, 5, 0, 3, 0, 3, 0, 2, 0, 2, 0, 2, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1
+};
+// Ramp-down: no deviation, decreasing PA output power.
+static const sfx_u8 RF_API_FIFO_FRAME_RAMP_DOWN[RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES] = {
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 2, 0, 2, 0, 2, 0, 3, 0, 3, 0, 5, 0, 7,
+    0, 10, 0, 14, 0, 19, 0, 25, 0, 31, 0, 39, 0, 60, 0, 220
+};
+// Bit 1: constant CW.
+static const sfx_u8 RF_API_FIFO_FRAME_BIT1[RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES] = {
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1
+};
+// Bit 0: amplitude shaping with positive phase shift in the middle of the symbol.
+static const sfx_u8 RF_API_FIFO_FRAME_BIT0_FDEV_POSITIVE[RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES] = {
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 2, 0, 2, 0, 2,
+    0, 3, 0, 3, 0, 5, 0, 7, 0, 10, 0, 14, 0, 19, 0, 25,
+    0, 31, 0, 39, 0, 60, 0, 220, RF_API_FDEV_POSITIVE, 220, 0, 60, 0, 39, 0, 31,
+    0, 25, 0, 19, 0, 14, 0, 10, 0, 7, 0, 5, 0, 3, 0, 3,
+    0, 2, 0, 2, 0, 2, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1
+};
+// Bit 0: amplitude shaping with negative phase shift in the middle of the symbol.
+static const sfx_u8 RF_API_FIFO_FRAME_BIT0_FDEV_NEGATIVE[RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES] = {
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 2, 0, 2, 0, 2,
+    0, 3, 0, 3, 0, 5, 0, 7, 0, 10, 0, 14, 0, 19, 0, 25,
+    0, 31, 0, 39, 0, 60, 0, 220, RF_API_FDEV_NEGATIVE, 220, 0, 60, 0, 39, 0, 31,
+    0, 25, 0, 19, 0, 14, 0, 10, 0, 7, 0, 5, 0, 3, 0, 3,
+    0, 2, 0, 2, 0, 2, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1
+};
+// Padding bit to ensure last ramp-down is completely transmitted.
+static const sfx_u8 RF_API_FIFO_FRAME_PADDING[RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
 #ifdef SIGFOX_EP_BIDIRECTIONAL
 static const sfx_u8 RF_API_DL_FT[SIGFOX_DL_FT_SIZE_BYTES] = SIGFOX_DL_FT;
 #endif
@@ -136,8 +181,6 @@ typedef struct {
     RF_API_state_t state;
     volatile RF_API_flags_t flags;
     // TX.
-    sfx_u8 symbol_fifo_buffer[RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES];
-    sfx_u8 ramp_fifo_buffer[RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES];
     sfx_u8 tx_bitstream[SIGFOX_UL_BITSTREAM_SIZE_BYTES];
     sfx_u8 tx_bitstream_size_bytes;
     sfx_u8 tx_byte_idx;
@@ -211,23 +254,18 @@ static RF_API_status_t _RF_API_internal_process(void) {
 #ifdef SIGFOX_EP_BIDIRECTIONAL
     RFE_status_t rfe_status = RFE_SUCCESS;
 #endif
+    const sfx_u8* symbol_frame = NULL;
     sfx_u8 s2lp_irq_flag = 0;
-    sfx_u8 idx = 0;
     // Perform state machine.
     switch (rf_api_ctx.state) {
     case RF_API_STATE_READY:
         // Nothing to do.
         break;
     case RF_API_STATE_TX_RAMP_UP:
-        // Fill ramp-up.
-        for (idx = 0; idx < RF_API_SYMBOL_PROFILE_SIZE_BYTES; idx++) {
-            rf_api_ctx.ramp_fifo_buffer[(2 * idx)] = 0; // Deviation.
-            rf_api_ctx.ramp_fifo_buffer[(2 * idx) + 1] = RF_API_RAMP_AMPLITUDE_PROFILE[RF_API_SYMBOL_PROFILE_SIZE_BYTES - idx - 1]; // PA output power.
-        }
-        // Load ramp-up buffer into FIFO.
+        // Load ramp-up frame into FIFO.
         s2lp_status = S2LP_send_command(S2LP_COMMAND_FLUSHTXFIFO);
         S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
-        s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.ramp_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
+        s2lp_status = S2LP_write_fifo((sfx_u8*) RF_API_FIFO_FRAME_RAMP_UP, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
         S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
         // Enable external GPIO interrupt.
         s2lp_status = S2LP_clear_all_irq();
@@ -256,20 +294,14 @@ static RF_API_status_t _RF_API_internal_process(void) {
             if ((rf_api_ctx.tx_bitstream[rf_api_ctx.tx_byte_idx] & (1 << (7 - rf_api_ctx.tx_bit_idx))) == 0) {
                 // Phase shift and amplitude shaping required.
                 rf_api_ctx.tx_fdev = (rf_api_ctx.tx_fdev == RF_API_FDEV_NEGATIVE) ? RF_API_FDEV_POSITIVE : RF_API_FDEV_NEGATIVE; // Toggle deviation.
-                for (idx = 0; idx < RF_API_SYMBOL_PROFILE_SIZE_BYTES; idx++) {
-                    rf_api_ctx.symbol_fifo_buffer[(2 * idx)] = (idx == RF_API_FIFO_BUFFER_FDEV_IDX) ? rf_api_ctx.tx_fdev : 0; // Deviation.
-                    rf_api_ctx.symbol_fifo_buffer[(2 * idx) + 1] = RF_API_BIT0_AMPLITUDE_PROFILE[idx]; // PA output power.
-                }
+                symbol_frame = (rf_api_ctx.tx_fdev == RF_API_FDEV_POSITIVE) ? RF_API_FIFO_FRAME_BIT0_FDEV_POSITIVE : RF_API_FIFO_FRAME_BIT0_FDEV_NEGATIVE;
             }
             else {
                 // Constant CW.
-                for (idx = 0; idx < RF_API_SYMBOL_PROFILE_SIZE_BYTES; idx++) {
-                    rf_api_ctx.symbol_fifo_buffer[(2 * idx)] = 0; // Deviation.
-                    rf_api_ctx.symbol_fifo_buffer[(2 * idx) + 1] = RF_API_BIT0_AMPLITUDE_PROFILE[0]; // PA output power.
-                }
+                symbol_frame = RF_API_FIFO_FRAME_BIT1;
             }
             // Load bit into FIFO.
-            s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.symbol_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
+            s2lp_status = S2LP_write_fifo((sfx_u8*) symbol_frame, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
             S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
             // Increment bit index.
             rf_api_ctx.tx_bit_idx++;
@@ -296,13 +328,8 @@ static RF_API_status_t _RF_API_internal_process(void) {
         S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
         // Check flag.
         if (s2lp_irq_flag != 0) {
-            // Fill ramp-down.
-            for (idx = 0; idx < RF_API_SYMBOL_PROFILE_SIZE_BYTES; idx++) {
-                rf_api_ctx.ramp_fifo_buffer[(2 * idx)] = 0; // FDEV.
-                rf_api_ctx.ramp_fifo_buffer[(2 * idx) + 1] = RF_API_RAMP_AMPLITUDE_PROFILE[idx]; // PA output power for ramp-down.
-            }
-            // Load ramp-down buffer into FIFO.
-            s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.ramp_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
+            // Load ramp-down frame into FIFO.
+            s2lp_status = S2LP_write_fifo((sfx_u8*) RF_API_FIFO_FRAME_RAMP_DOWN, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
             S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
             // Update state.
             rf_api_ctx.state = RF_API_STATE_TX_PADDING_BIT;
@@ -317,12 +344,8 @@ static RF_API_status_t _RF_API_internal_process(void) {
         S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
         // Check flag.
         if (s2lp_irq_flag != 0) {
-            // Padding bit to ensure last ramp down is completely transmitted.
-            for (idx = 0; idx < RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES; idx++) {
-                rf_api_ctx.symbol_fifo_buffer[idx] = 0x00;
-            }
-            // Load padding buffer into FIFO.
-            s2lp_status = S2LP_write_fifo((sfx_u8*) rf_api_ctx.symbol_fifo_buffer, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
+            // Load padding frame into FIFO.
+            s2lp_status = S2LP_write_fifo((sfx_u8*) RF_API_FIFO_FRAME_PADDING, RF_API_SYMBOL_FIFO_BUFFER_SIZE_BYTES);
             S2LP_stack_exit_error(ERROR_BASE_S2LP, (RF_API_status_t) RF_API_ERROR_DRIVER_S2LP);
             // Update state.
             rf_api_ctx.state = RF_API_STATE_TX_END;